@@ -0,0 +1,70 @@
+#include "arena.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#define ARENA_ALIGNMENT _Alignof(max_align_t)
+
+void arena_init(Arena* arena, size_t block_size) {
+    arena->head = NULL;
+    arena->current = NULL;
+    arena->block_size = block_size ? block_size : ARENA_DEFAULT_BLOCK_SIZE;
+}
+
+void* arena_alloc(Arena* arena, size_t size) {
+    if (size > SIZE_MAX - ARENA_ALIGNMENT) return NULL;
+    // Round up so the next allocation stays aligned as well
+    size = (size + ARENA_ALIGNMENT - 1) & ~(ARENA_ALIGNMENT - 1);
+
+    // Move through blocks that are left over from before the last reset
+    while (arena->current && arena->current->capacity - arena->current->used < size && arena->current->next) {
+        arena->current = arena->current->next;
+        arena->current->used = 0;
+    }
+
+    ArenaBlock* block = arena->current;
+    if (!block || block->capacity - block->used < size) {
+        size_t capacity = size > arena->block_size ? size : arena->block_size;
+        block = malloc(sizeof(ArenaBlock) + capacity);
+        if (!block) return NULL;
+        block->next = NULL;
+        block->capacity = capacity;
+        block->used = 0;
+
+        if (arena->current) {
+            arena->current->next = block;
+        } else {
+            arena->head = block;
+        }
+        arena->current = block;
+    }
+
+    void* ptr = (unsigned char*) block->data + block->used;
+    block->used += size;
+    return ptr;
+}
+
+void* arena_calloc(Arena* arena, size_t count, size_t size) {
+    if (size != 0 && count > SIZE_MAX / size) return NULL;
+    void* ptr = arena_alloc(arena, count * size);
+    if (ptr) memset(ptr, 0, count * size);
+    return ptr;
+}
+
+void arena_reset(Arena* arena) {
+    arena->current = arena->head;
+    if (arena->head) arena->head->used = 0;
+}
+
+void arena_free(Arena* arena) {
+    if (!arena) return;
+
+    ArenaBlock* block = arena->head;
+    while (block) {
+        ArenaBlock* next = block->next;
+        free(block);
+        block = next;
+    }
+    arena->head = NULL;
+    arena->current = NULL;
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include <stddef.h>
+
+// Default capacity of a single arena block in bytes, larger allocations get a block of their own
+#define ARENA_DEFAULT_BLOCK_SIZE (64 * 1024)
+
+typedef struct ArenaBlock {
+    struct ArenaBlock* next;
+    size_t capacity;
+    size_t used;
+    max_align_t data[];
+} ArenaBlock;
+
+typedef struct {
+    ArenaBlock* head;
+    ArenaBlock* current;
+    size_t block_size;
+} Arena;
+
+/**
+ * @brief Initializes an empty arena.
+ *
+ * No memory is allocated until the first call to `arena_alloc`. An arena is a bump allocator: allocations
+ * cannot be freed individually, instead everything allocated from an arena is released at once with
+ * `arena_reset` (memory is kept for reuse) or `arena_free` (memory is returned to the system).
+ *
+ * @param arena Pointer to the arena to initialize.
+ * @param block_size Capacity of each block in bytes, `0` selects `ARENA_DEFAULT_BLOCK_SIZE`.
+ */
+void arena_init(Arena* arena, size_t block_size);
+
+/**
+ * @brief Allocates memory from an arena.
+ *
+ * The returned memory is suitably aligned for any type and uninitialized. A new block is only requested from
+ * the system allocator if none of the arena's existing blocks has enough space left.
+ *
+ * @param arena Pointer to an initialized arena.
+ * @param size Number of bytes to allocate.
+ * @return Pointer to the allocated memory, or NULL if memory allocation fails.
+ */
+void* arena_alloc(Arena* arena, size_t size);
+
+/**
+ * @brief Allocates zero-initialized memory for an array from an arena.
+ *
+ * @param arena Pointer to an initialized arena.
+ * @param count Number of elements.
+ * @param size Size of each element in bytes.
+ * @return Pointer to the allocated memory, or NULL if memory allocation fails or the size overflows.
+ */
+void* arena_calloc(Arena* arena, size_t count, size_t size);
+
+/**
+ * @brief Releases every allocation of an arena while keeping its blocks for reuse.
+ *
+ * @param arena Pointer to an initialized arena. All pointers previously returned by it become invalid.
+ */
+void arena_reset(Arena* arena);
+
+/**
+ * @brief Returns all blocks of an arena to the system allocator.
+ *
+ * The arena is left empty and can be used again.
+ *
+ * @param arena Pointer to an initialized arena. If NULL, the function does nothing.
+ */
+void arena_free(Arena* arena);
@@ -0,0 +1,167 @@
+#include "board_view.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifndef RESET
+#define RESET "\033[0m"
+#endif
+
+#define SNAKECOL "\033[1;31m"
+#define LADDERCOL "\033[1;32m"
+
+int parse_row_range(const char* arg, int* first_row, int* last_row) {
+    if (!arg || !first_row || !last_row) {
+        LOG_ERROR("Invalid row range or output (NULL pointer).");
+        return 1;
+    }
+
+    char* end;
+    long first = strtol(arg, &end, 10);
+    if (end == arg || strncmp(end, "..", 2) != 0) {
+        LOG_ERROR("Invalid row range '%s', expected the format a..b.", arg);
+        return 1;
+    }
+    const char* rest = end + 2;
+    long last = strtol(rest, &end, 10);
+    if (end == rest || *end != '\0' || first < 1 || last < first) {
+        LOG_ERROR("Invalid row range '%s', rows are 1-based and a must not be larger than b.", arg);
+        return 1;
+    }
+
+    *first_row = (int) first;
+    *last_row = (int) last;
+    return 0;
+}
+
+void print_board_rows(GameBoard* board, int first_row, int last_row) {
+    if (!board || !board->start || !board->jumps) {
+        LOG_ERROR("Invalid board or start point (NULL pointer).");
+        return;
+    }
+
+    int first = first_row < 1 ? 1 : first_row;
+    int last = last_row > board->rows ? board->rows : last_row;
+    if (first > last) {
+        LOG_INFO("Rows %d..%d are outside of the board (%d rows), nothing to print.", first_row, last_row, board->rows);
+        return;
+    }
+
+    puts("");
+    for (int r = first - 1; r < last; r++) {
+        printf("| ");
+        for (int c = 0; c < board->cols; c++) {
+            int index = r * board->cols + c;
+
+            printf("[%3d] ", index + 1);
+
+            switch (board->start[index].ft) {
+                case SNAKE:
+                    printf(SNAKECOL "S -> %3d" RESET, board->jumps[index] + 1);
+                    break;
+                case LADDER:
+                    printf(LADDERCOL "L -> %3d" RESET, board->jumps[index] + 1);
+                    break;
+                default:
+                    printf("N       ");
+                    break;
+            }
+            printf(" | ");
+        }
+        puts("");
+    }
+    puts("");
+}
+
+void print_game_board(GameBoard* board) {
+    print_board_rows(board, 1, board ? board->rows : 0);
+}
+
+/**
+ * @brief Marks every square that can be landed on from the start, returns the number of marked squares.
+ *
+ * Breadth-first search over dice moves and snakes/ladders, every square is queued at most once.
+ */
+static int mark_reachable(GameBoard* board, Config* config, char* reached, int* queue) {
+    const int num_fields = board->rows * board->cols;
+    int head = 0, tail = 0;
+
+    // The player starts off the board, so the first roll can land on any of the first squares
+    for (int d = 0; d < config->dice_sides && d < num_fields; d++) {
+        reached[d] = 1;
+        queue[tail++] = d;
+    }
+
+    while (head < tail) {
+        int index = queue[head++];
+        if (board->jumps[index] != index) {
+            // Landing on a snake or ladder moves the player on immediately
+            int target = board->jumps[index];
+            if (!reached[target]) {
+                reached[target] = 1;
+                queue[tail++] = target;
+            }
+            continue;
+        }
+
+        for (int d = 1; d <= config->dice_sides; d++) {
+            int target = index + d;
+            if (target >= num_fields) {
+                if (!config->allow_overshoot) break;
+                target = num_fields - 1;
+            }
+            if (!reached[target]) {
+                reached[target] = 1;
+                queue[tail++] = target;
+            }
+        }
+    }
+    return tail;
+}
+
+void print_board_summary(GameBoard* board, Config* config, Arena* scratch) {
+    if (!board || !board->start || !board->jumps || !config || !scratch) {
+        LOG_ERROR("Invalid board, config or arena (NULL pointer).");
+        return;
+    }
+
+    const int num_fields = board->rows * board->cols;
+    int num_snakes = 0, num_ladders = 0;
+    for (int i = 0; i < num_fields; i++) {
+        if (board->start[i].ft == SNAKE) num_snakes++;
+        else if (board->start[i].ft == LADDER) num_ladders++;
+    }
+
+    char* reached = arena_calloc(scratch, num_fields, sizeof(char));
+    int* queue = arena_alloc(scratch, sizeof(int) * num_fields);
+    if (!reached || !queue) {
+        LOG_ERROR("Memory allocation failed for reachability search.");
+        return;
+    }
+    int num_reachable = mark_reachable(board, config, reached, queue);
+
+    printf("\n===========================\n");
+    printf("Board Summary:\n");
+    printf("  Grid Size       : %d x %d (%d squares)\n", board->rows, board->cols, num_fields);
+    printf("  Snakes          : %d\n", num_snakes);
+    printf("  Ladders         : %d\n", num_ladders);
+    printf("  Density         : %.2f%% of squares start a snake or ladder\n",
+        (double) (num_snakes + num_ladders) / num_fields * 100);
+    printf("  Reachable       : %d of %d squares, last square %s\n", num_reachable, num_fields,
+        reached[num_fields - 1] ? "reachable" : "NOT reachable");
+
+    printf("\n--- Transitions (%d) ---\n", num_snakes + num_ladders);
+    if (num_snakes + num_ladders == 0) {
+        printf("(None)\n");
+    }
+    for (int i = 0; i < num_fields; i++) {
+        if (board->start[i].ft == SNAKE) {
+            printf(SNAKECOL "  Snake " RESET " %6d -> %6d  (%+d)%s\n", i + 1, board->jumps[i] + 1,
+                board->jumps[i] - i, reached[i] ? "" : "  unreachable");
+        } else if (board->start[i].ft == LADDER) {
+            printf(LADDERCOL "  Ladder" RESET " %6d -> %6d  (%+d)%s\n", i + 1, board->jumps[i] + 1,
+                board->jumps[i] - i, reached[i] ? "" : "  unreachable");
+        }
+    }
+    printf("===========================\n");
+}
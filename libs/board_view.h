@@ -0,0 +1,51 @@
+#pragma once
+#include "config_manager.h"
+#include "game_board.h"
+#include "arena.h"
+
+// Boards with more squares are summarized instead of printed as a full grid unless rows are selected
+#define BOARD_VIEW_MAX_FIELDS 400
+
+/**
+ * @brief Parses a 1-based inclusive row range of the format `a..b` (e.g. `3..7`).
+ *
+ * @param arg The range to parse.
+ * @param first_row Receives the first row of the range.
+ * @param last_row Receives the last row of the range.
+ * @return int Returns `0` on success, `1` if the range is malformed or empty.
+ */
+int parse_row_range(const char* arg, int* first_row, int* last_row);
+
+/**
+ * @brief Prints the rows `first_row` to `last_row` (1-based, inclusive) of the game board as a grid.
+ *
+ * Displays each field in the selected rows, indicating whether it is a normal node (`N`),
+ * a snake (`S -> X`), or a ladder (`L -> X`) and its corresponding destination.
+ * Destinations are read from the board's `jumps`, so printing costs O(squares) and output is streamed
+ * without buffering. Rows outside of the board are clipped.
+ *
+ * @param board Pointer to the `GameBoard` to be printed. If NULL or uninitialized, the function does nothing.
+ * @param first_row First row to print.
+ * @param last_row Last row to print.
+ */
+void print_board_rows(GameBoard* board, int first_row, int last_row);
+
+/**
+ * @brief Prints every row of the game board as a grid, see `print_board_rows`.
+ *
+ * @param board Pointer to the `GameBoard` to be printed. If NULL or uninitialized, the function does nothing.
+ */
+void print_game_board(GameBoard* board);
+
+/**
+ * @brief Prints a compact summary of the game board instead of the full grid.
+ *
+ * The summary contains the number of snakes and ladders, their density (share of squares a snake or ladder
+ * starts on), how many squares can be landed on from the start and whether the last square can be reached,
+ * followed by every snake and ladder in board order.
+ *
+ * @param board Pointer to the `GameBoard` to be summarized.
+ * @param config Pointer to the configuration the board was built from, provides dice and overshoot rule.
+ * @param scratch Pointer to an arena for the reachability search, it can be reset once the function returns.
+ */
+void print_board_summary(GameBoard* board, Config* config, Arena* scratch);
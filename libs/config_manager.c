@@ -4,19 +4,6 @@
 #include <ctype.h>
 #include <string.h>
 
-/**
- * @brief Checks for duplicate snake or ladder positions in the configuration.
- *
- * Ensures that the given start or end position does not already belong to an existing snake or ladder,
- * either as a start or an end point. Prevents overlapping or conflicting transitions.
- *
- * @param start The proposed start position of a new snake or ladder.
- * @param end The proposed end position of a new snake or ladder.
- * @param snake_idx Number of snakes already added to the configuration.
- * @param ladder_idx Number of ladders already added to the configuration.
- * @param config Pointer to the configuration data where snakes and ladders are stored.
- * @return 1 if a conflict exists; 0 otherwise.
- */
 int check_for_existence(int start, int end, int snake_idx, int ladder_idx, Config* config) {
     // Check if there's a snake with given start/end position
     for (int i = 0; i < snake_idx; i++) {
@@ -37,9 +24,43 @@ int check_for_existence(int start, int end, int snake_idx, int ladder_idx, Confi
     return 0;
 }
 
+int validate_transition(int start, int end, int is_snake, int snake_idx, int ladder_idx, Config* config) {
+    if (start == end) {
+        LOG_INFO("Transition %d:%d: No snake or ladder should start or end on the same square as itself. Therefore it will not be included on the board.", start, end);
+    } else if (start == config->cols * config->rows) { // rows and cols are 1-based 
+        LOG_INFO("Transition %d:%d: No snake or ladder should start at the last square. It will not be included on the board.", start, end);
+    } else if (check_for_existence(start, end, snake_idx, ladder_idx, config)){
+        LOG_INFO("Transition %d:%d: No snake or ladder should start or end on the same square as any other snake or ladder. It will not be included on the board.", start, end);
+    } else if (start <= 0 || start > config->cols * config->rows || end <= 0 || end > config->cols * config->rows) {
+        LOG_INFO("Transition %d:%d: No snake or ladder should reach out of bound of the game field. It will not be included on the board.", start, end);
+    } else if (is_snake && start < end) {
+        LOG_INFO("Transition %d:%d: Snakes have to start with a larger value than it ends with otherwise it would be a ladder. It will not be included on the board.", start, end);
+    } else if (!is_snake && start > end) {
+        LOG_INFO("Transition %d:%d: Ladders have to start with a smaller value than it ends with otherwise it would be a snake. It will not be included on the board.", start, end);
+    } else {
+        return 1;
+    }
+    return 0;
+}
+
 int parse_config_file(const char* filename, Config* config) {
-    if (!config) {
-        logm(ERROR, "parse_config_file", "Invalid Config (NULL pointer).");
+    FILE* file = fopen(filename, "r");
+    if (!file) {
+        LOG_ERROR("Encounterd error when trying to open given file '%s', it might not exists!", filename);
+        return 1;
+    }
+
+    int return_val = parse_config_stream(file, config);
+    fclose(file);
+    return return_val;
+}
+
+/**
+ * @brief Parses the lines of a configuration stream, see `parse_config_stream`.
+ */
+static int parse_config_lines(FILE* file, Config* config) {
+    if (!file || !config) {
+        LOG_ERROR("Invalid file or Config (NULL pointer).");
         return 1;
     }
 
@@ -50,24 +71,23 @@ int parse_config_file(const char* filename, Config* config) {
     config->max_simulation_steps = 1000;
     config->allow_overshoot = 1;
     config->dice_sides = 6;
-    
-    FILE* file = fopen(filename, "r");
-    if (!file) {
-        logm(ERROR, "parse_config_file", "Encounterd error when trying to open given file, it might not exists!");
-        return 1;
-    }
+    config->seed = 0;
+    config->num_snakes = 0;
+    config->num_ladders = 0;
 
-    char* original_ptr = malloc(sizeof(char) * MAX_LINE_LENGTH);
-    char* line = original_ptr;
-    int parsing_snakes = 0, parsing_ladders = 0, snake_idx = 0, ladder_idx = 0;
 
-    while (fgets(line, MAX_LINE_LENGTH, file)) {
+    char buffer[MAX_LINE_LENGTH];
+    char* line = buffer;
+    int parsing_snakes = 0, parsing_ladders = 0, snake_idx = 0, ladder_idx = 0, line_number = 0;
+
+    while (fgets(buffer, MAX_LINE_LENGTH, file)) {
+        line = buffer;
+        line_number++;
         // Strip comments and newlines
         char* comment = strchr(line, '#');
         if (comment) *comment = '\0';
 
-        char* newline = strchr(line, '\n');
-        if (newline) *newline = '\0';
+        line[strcspn(line, "\r\n")] = '\0';
 
         // Skip empty lines
         if (strlen(line) == 0) continue;
@@ -78,21 +98,21 @@ int parse_config_file(const char* filename, Config* config) {
         if (strncmp(line, "ITERATIONS=", 11) == 0) {
             int iterations = atoi(line + 11);
             if (iterations <= 0) {
-                logm(ERROR, "parse_config_file", "Number of iterations must not be negative or zero. Check your config file.");
+                LOG_ERROR("Line %d: Number of iterations must not be negative or zero (got %d). Check your config file.", line_number, iterations);
                 return 1;
             }
             config->iterations = iterations;
         } else if (strncmp(line, "MAXSIMSTEPS=", 12) == 0) {
             int max_simulation_steps = atoi(line + 12);  
             if (max_simulation_steps <= 0) {
-                logm(ERROR, "parse_config_file", "Number of maximum simulation steps must not be negative or zero. Check your config file.");
+                LOG_ERROR("Line %d: Number of maximum simulation steps must not be negative or zero (got %d). Check your config file.", line_number, max_simulation_steps);
                 return 1;
             }
             config->max_simulation_steps = max_simulation_steps;
         } else if (strncmp(line, "ROWS=", 5) == 0) {
             int rows = atoi(line + 5);
             if (rows <= 0) {
-                logm(ERROR, "parse_config_file", "Number of rows must not be negative or zero, will now play with default number of rows (10).");
+                LOG_ERROR("Line %d: Number of rows must not be negative or zero (got %d), will now play with default number of rows (10).", line_number, rows);
                 config->rows = 10;
             } else {
                 config->rows = rows;
@@ -100,7 +120,7 @@ int parse_config_file(const char* filename, Config* config) {
         } else if (strncmp(line, "COLS=", 5) == 0) {
             int cols = atoi(line + 5);
             if (cols <= 0) {
-                logm(ERROR, "parse_config_file", "Number of cols must not be negative or zero, will now play with default number of cols (10).");
+                LOG_ERROR("Line %d: Number of cols must not be negative or zero (got %d), will now play with default number of cols (10).", line_number, cols);
                 config->cols = 10;
             } else {
                 config->cols = cols;
@@ -108,17 +128,27 @@ int parse_config_file(const char* filename, Config* config) {
         } else if (strncmp(line, "DICE=", 5) == 0) {
             int dice_sides = atoi(line + 5);
             if (dice_sides <= 1) {
-                logm(ERROR, "parse_config_file", "Dice needs to be atleast 2, will now play with default dice sides (6).");
+                LOG_ERROR("Line %d: Dice needs to be atleast 2 (got %d), will now play with default dice sides (6).", line_number, dice_sides);
                 config->dice_sides = 6;
             } else {
                 config->dice_sides = dice_sides;
             }
         } else if (strncmp(line, "ALLOW_OVERSHOOT=", 16) == 0) {
             config->allow_overshoot = (strncmp(line + 16, "true", 4) == 0);
+        } else if (strncmp(line, "LOG_LEVEL=", 10) == 0) {
+            LogLevel log_level;
+            if (parse_log_level(line + 10, &log_level)) {
+                LOG_ERROR("Line %d: Unknown log level '%s', use ERROR, INFO or DEBUG.", line_number, line + 10);
+            } else {
+                // Applied right away so it already filters the messages of the following lines
+                set_log_level(log_level);
+            }
+        } else if (strncmp(line, "SEED=", 5) == 0) {
+            config->seed = strtoull(line + 5, NULL, 10);
         } else if (strncmp(line, "SNAKES=", 7) == 0) {
             int num_snakes = atoi(line + 7);
             if (num_snakes < 0) {
-                logm(ERROR, "parse_config_file", "Number of snakes must not be negative. Check your config file.");
+                LOG_ERROR("Line %d: Number of snakes must not be negative (got %d). Check your config file.", line_number, num_snakes);
                 return 1;
             }
             config->num_snakes = num_snakes;
@@ -127,7 +157,7 @@ int parse_config_file(const char* filename, Config* config) {
         } else if (strncmp(line, "LADDERS=", 8) == 0) {
             int num_ladders = atoi(line + 8);
             if (num_ladders < 0) {
-                logm(ERROR, "parse_config_file", "Number of ladders must not be negative. Check your config file.");
+                LOG_ERROR("Line %d: Number of ladders must not be negative (got %d). Check your config file.", line_number, num_ladders);
                 return 1;
             }
             config->num_ladders = num_ladders;
@@ -136,43 +166,44 @@ int parse_config_file(const char* filename, Config* config) {
         } else {
             int start, end;
             if (sscanf(line, "%d:%d", &start, &end) == 2) {
-                if (start == end) {
-                    logm(INFO, "parse_config_file", "No snake or ladder should start or end on the same square as itself. Therefore it will not be included on the board.");
-                } else if (start == config->cols * config->rows) { // rows and cols are 1-based 
-                    logm(INFO, "parse_config_file", "No snake or ladder should start at the last square. It will not be included on the board.");
-                } else if (check_for_existence(start, end, snake_idx, ladder_idx, config)){
-                    logm(INFO, "parse_config_file", "No snake or ladder should start or end on the same square as any other snake or ladder. It will not be included on the board.");
-                } else if (start <= 0 || start > config->cols * config->rows || end <= 0 || end > config->cols * config->rows) {
-                    logm(INFO, "parse_config_file", "No snake or ladder should reach out of bound of the game field. It will not be included on the board.");
-                } else if (parsing_snakes && start < end) {
-                    logm(INFO, "parse_config_file", "Snakes have to start with a larger value than it ends with otherwise it would be a ladder. It will not be included on the board.");
-                } else if (parsing_ladders && start > end) {
-                    logm(INFO, "parse_config_file", "Ladders have to start with a smaller value than it ends with otherwise it would be a snake. It will not be included on the board.");
-                } else {
-                    // If no error is detected with given ladder/snake positions included them in the board
-                    if (parsing_snakes && snake_idx < config->num_snakes && snake_idx < MAX_SNAKES) {                    
-                        config->snakes[snake_idx].start = start;
-                        config->snakes[snake_idx].end = end;
-                        config->snakes[snake_idx].times_used = 0;
-                        snake_idx++;
-                    } else if (parsing_ladders && ladder_idx < config->num_ladders && ladder_idx < MAX_LADDERS) {
-                        config->ladders[ladder_idx].start = start;
-                        config->ladders[ladder_idx].end = end;
-                        config->ladders[ladder_idx].times_used = 0;
-                        ladder_idx++;
-                    }
-                }                
+                if (!validate_transition(start, end, parsing_snakes, snake_idx, ladder_idx, config)) {
+                    continue;
+                }
+
+                // If no error is detected with given ladder/snake positions included them in the board
+                if (parsing_snakes && snake_idx < config->num_snakes && snake_idx < MAX_SNAKES) {                    
+                    config->snakes[snake_idx].start = start;
+                    config->snakes[snake_idx].end = end;
+                    config->snakes[snake_idx].times_used = 0;
+                    snake_idx++;
+                } else if (parsing_ladders && ladder_idx < config->num_ladders && ladder_idx < MAX_LADDERS) {
+                    config->ladders[ladder_idx].start = start;
+                    config->ladders[ladder_idx].end = end;
+                    config->ladders[ladder_idx].times_used = 0;
+                    ladder_idx++;
+                }
             }
         }
     }
-    free(original_ptr);
-    fclose(file);
+    // Only keep the snakes and ladders that passed validation
+    config->num_snakes = snake_idx;
+    config->num_ladders = ladder_idx;
     return 0;
 }
 
+int parse_config_stream(FILE* file, Config* config) {
+    LogLevel previous_level = log_threshold;
+    int return_val = parse_config_lines(file, config);
+    // A rejected file must not leave its LOG_LEVEL behind
+    if (return_val) set_log_level(previous_level);
+    // Rejected transitions of one file are summarized together, the next file starts reporting again
+    log_flush();
+    return return_val;
+}
+
 void print_config(Config* config) {
     if (!config) {
-        logm(ERROR, "print_config", "Invalid Config (NULL pointer).");
+        LOG_ERROR("Invalid Config (NULL pointer).");
         return;
     }
     
@@ -180,6 +211,7 @@ void print_config(Config* config) {
     printf("Simulation Configuration:\n");
     printf("  Iterations      : %d\n", config->iterations);
     printf("  Max Sim Steps   : %d\n", config->max_simulation_steps);
+    printf("  Seed            : %llu\n", config->seed);
     printf("Board Configuration:\n");
     printf("  Grid Size       : %d x %d\n", config->rows, config->cols);
     printf("  Dice Sides      : %d\n", config->dice_sides);
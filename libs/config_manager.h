@@ -1,4 +1,5 @@
 #pragma once
+#include <stdio.h>
 #include "logger.h"
 #define MAX_SNAKES 100
 #define MAX_LADDERS 100
@@ -18,6 +19,7 @@ typedef struct {
     int cols;
     int dice_sides;
     int allow_overshoot;
+    unsigned long long seed;
 
     int num_snakes;
     Transition snakes[MAX_SNAKES];
@@ -40,6 +42,8 @@ typedef struct {
  * - COLS (must be > 0)
  * - DICE (must be ≥ 2, otherwise defaults to 6 with a warning)
  * - ALLOW_OVERSHOOT (true/false)
+ * - SEED (random generator seed, 0 or missing seeds from the current time)
+ * - LOG_LEVEL (ERROR, INFO or DEBUG, applied to the logger right away and reverted if parsing fails)
  * - SNAKES= followed by snake definitions (format: `start:end`)
  * - LADDERS= followed by ladder definitions (format: `start:end`)
  *
@@ -55,6 +59,52 @@ typedef struct {
  */
 int parse_config_file(const char* filename, Config* config);
 
+/**
+ * @brief Parses the game configuration from an already opened stream into a Config structure.
+ *
+ * Behaves exactly like `parse_config_file` but reads from `file`, which allows configurations that are held
+ * in memory (e.g. via `fmemopen`). The stream is not closed.
+ *
+ * @param file The stream to read the configuration from.
+ * @param config Pointer to a Config structure that will be populated.
+ *
+ * @return int Returns `0` on success, `1` on failure (e.g., invalid input).
+ */
+int parse_config_stream(FILE* file, Config* config);
+
+/**
+ * @brief Checks for duplicate snake or ladder positions in the configuration.
+ *
+ * Ensures that the given start or end position does not already belong to an existing snake or ladder,
+ * either as a start or an end point. Prevents overlapping or conflicting transitions.
+ *
+ * @param start The proposed start position of a new snake or ladder.
+ * @param end The proposed end position of a new snake or ladder.
+ * @param snake_idx Number of snakes already added to the configuration.
+ * @param ladder_idx Number of ladders already added to the configuration.
+ * @param config Pointer to the configuration data where snakes and ladders are stored.
+ * @return 1 if a conflict exists; 0 otherwise.
+ */
+int check_for_existence(int start, int end, int snake_idx, int ladder_idx, Config* config);
+
+/**
+ * @brief Validates a proposed snake or ladder against the game rules.
+ *
+ * Applies every placement rule used while parsing: the transition must not start and end on the same
+ * square, must not start on the last square, must not collide with an existing transition
+ * (see `check_for_existence`), must stay within the board and must point in the right direction
+ * (snakes go down, ladders go up). The reason for a rejection is logged as an info message.
+ *
+ * @param start The proposed start position (1-based).
+ * @param end The proposed end position (1-based).
+ * @param is_snake `1` if the transition is a snake, `0` if it is a ladder.
+ * @param snake_idx Number of snakes already added to the configuration.
+ * @param ladder_idx Number of ladders already added to the configuration.
+ * @param config Pointer to the configuration the transition should be added to.
+ * @return 1 if the transition is valid; 0 otherwise.
+ */
+int validate_transition(int start, int end, int is_snake, int snake_idx, int ladder_idx, Config* config);
+
 /**
  * @brief Prints the contents of a Config structure in a human-readable format.
  *
@@ -0,0 +1,143 @@
+#include "editor.h"
+#include "markov.h"
+#include <string.h>
+#include <ctype.h>
+
+/**
+ * @brief Removes the snake or ladder starting on `start` from the configuration.
+ *
+ * @param removed Receives the removed transition.
+ * @param was_snake Receives `1` if the removed transition was a snake, `0` if it was a ladder.
+ * @return 1 if a transition was removed; 0 if there is none starting on `start`.
+ */
+static int remove_transition(Config* config, int start, Transition* removed, int* was_snake) {
+    for (int i = 0; i < config->num_snakes; i++) {
+        if (config->snakes[i].start == start) {
+            *removed = config->snakes[i];
+            *was_snake = 1;
+            memmove(&config->snakes[i], &config->snakes[i + 1], sizeof(Transition) * (config->num_snakes - i - 1));
+            config->num_snakes--;
+            return 1;
+        }
+    }
+
+    for (int i = 0; i < config->num_ladders; i++) {
+        if (config->ladders[i].start == start) {
+            *removed = config->ladders[i];
+            *was_snake = 0;
+            memmove(&config->ladders[i], &config->ladders[i + 1], sizeof(Transition) * (config->num_ladders - i - 1));
+            config->num_ladders--;
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Validates a snake or ladder and appends it to the configuration.
+ *
+ * @return 1 if the transition was added; 0 if it is invalid or there is no space left.
+ */
+static int add_transition(Config* config, int start, int end, int is_snake) {
+    if ((is_snake && config->num_snakes >= MAX_SNAKES) || (!is_snake && config->num_ladders >= MAX_LADDERS)) {
+        LOG_INFO("Maximum number of snakes or ladders reached. It will not be included on the board.");
+        return 0;
+    }
+
+    if (!validate_transition(start, end, is_snake, config->num_snakes, config->num_ladders, config)) {
+        return 0;
+    }
+
+    Transition* t = is_snake ? &config->snakes[config->num_snakes++] : &config->ladders[config->num_ladders++];
+    t->start = start;
+    t->end = end;
+    t->times_used = 0;
+    return 1;
+}
+
+static void print_solution(int edit, const char* command, MarkovSolver* solver) {
+    printf("[%3d] %-32s -> Expected rolls: %8.3f | Abort probability: %.4f%%\n",
+        edit, command, solver->expected_rolls, solver->abort_probability * 100);
+}
+
+int run_edit_script(FILE* script, Config* config) {
+    if (!script || !config) {
+        LOG_ERROR("Invalid script or config (NULL pointer).");
+        return 1;
+    }
+
+    // The arena owns the solver for the whole session
+    Arena arena;
+    arena_init(&arena, 0);
+    MarkovSolver* solver = create_markov_solver(config, &arena);
+    if (!solver) {
+        LOG_ERROR("Could not solve the initial board.");
+        arena_free(&arena);
+        return 1;
+    }
+
+    puts("\n=========== Board Edit Session ===========\n");
+    print_solution(0, "initial board", solver);
+
+    char line[MAX_LINE_LENGTH];
+    int edit = 0;
+
+    while (fgets(line, MAX_LINE_LENGTH, script)) {
+        // Every command is its own scope for repeated messages, so each rejected edit is reported
+        log_flush();
+
+        // Strip comments and newlines
+        char* comment = strchr(line, '#');
+        if (comment) *comment = '\0';
+        line[strcspn(line, "\r\n")] = '\0';
+
+        char* command = line;
+        while (isspace(*command)) command++;
+        if (strlen(command) == 0) continue;
+
+        int start, end, new_start, new_end, was_snake;
+        char kind[16];
+        Transition removed;
+
+        if (sscanf(command, "add %15s %d:%d", kind, &start, &end) == 3) {
+            int is_snake = strcmp(kind, "snake") == 0;
+            if (!is_snake && strcmp(kind, "ladder") != 0) {
+                LOG_ERROR("Unknown transition type, use 'snake' or 'ladder'.");
+                continue;
+            }
+            if (!add_transition(config, start, end, is_snake)) continue;
+            markov_set_transition(solver, start, end);
+        } else if (sscanf(command, "move %d %d:%d", &start, &new_start, &new_end) == 3) {
+            if (!remove_transition(config, start, &removed, &was_snake)) {
+                LOG_ERROR("There is no snake or ladder starting on the given square.");
+                continue;
+            }
+            if (!add_transition(config, new_start, new_end, was_snake)) {
+                // Restore the original transition
+                add_transition(config, removed.start, removed.end, was_snake);
+                continue;
+            }
+            markov_set_transition(solver, start, 0);
+            markov_set_transition(solver, new_start, new_end);
+        } else if (sscanf(command, "remove %d", &start) == 1) {
+            if (!remove_transition(config, start, &removed, &was_snake)) {
+                LOG_ERROR("There is no snake or ladder starting on the given square.");
+                continue;
+            }
+            markov_set_transition(solver, start, 0);
+        } else if (strcmp(command, "print") == 0) {
+            print_config(config);
+            continue;
+        } else {
+            LOG_ERROR("Unknown edit command, use 'add', 'remove', 'move' or 'print'.");
+            continue;
+        }
+
+        print_solution(++edit, command, solver);
+    }
+
+    puts("\n==========================================\n");
+    arena_free(&arena);
+    return 0;
+}
@@ -0,0 +1,25 @@
+#pragma once
+#include <stdio.h>
+#include "config_manager.h"
+
+/**
+ * @brief Applies a stream of snake and ladder edits to a configuration and reports the exact solution after each edit.
+ *
+ * The board is solved once as an absorbing Markov chain (see `create_markov_solver`). Every following edit only
+ * updates the previous solution incrementally, so expected rolls and abort probability are available without
+ * re-solving or re-simulating the whole board.
+ *
+ * Supported commands (one per line, squares are 1-based):
+ * - `add snake START:END` / `add ladder START:END`
+ * - `remove START` removes the snake or ladder starting on START
+ * - `move START NEWSTART:NEWEND` moves the snake or ladder starting on START
+ * - `print` prints the current configuration
+ *
+ * @param script Stream to read the commands from (e.g. a file or `stdin`).
+ * @param config Pointer to a parsed configuration, it is modified by the edits.
+ * @return int Returns `0` on success, `1` if the solver could not be created.
+ *
+ * @note Lines beginning with '#' are treated as comments.
+ * @note Every added or moved transition goes through `validate_transition`, invalid edits are skipped.
+ */
+int run_edit_script(FILE* script, Config* config);
@@ -2,135 +2,90 @@
 #include <stdlib.h>
 #include <stdio.h>
 
-#ifndef RESET
-#define RESET "\033[0m"
-#endif
-
-#define SNAKECOL "\033[1;31m"
-#define LADDERCOL "\033[1;32m"
+void fill_jumps(Config* config, int* jumps) {
+    const int num_fields = config->rows * config->cols;
+    for (int i = 0; i < num_fields; i++) {
+        jumps[i] = i;
+    }
+    for (int j = 0; j < config->num_snakes; j++) {
+        jumps[config->snakes[j].start - 1] = config->snakes[j].end - 1;
+    }
+    for (int j = 0; j < config->num_ladders; j++) {
+        jumps[config->ladders[j].start - 1] = config->ladders[j].end - 1;
+    }
+}
 
-GameBoard* create_game_board(Config* config) {
-    if (!config) {
-        logm(ERROR, "create_game_board", "Invalid Config (NULL pointer).");
+GameBoard* create_game_board(Config* config, Arena* arena) {
+    if (!config || !arena) {
+        LOG_ERROR("Invalid Config or Arena (NULL pointer).");
         return NULL;
     }
     
     int num_fields = config->rows * config->cols;
-    GameBoard* game_board = malloc(sizeof(GameBoard));
-    game_board->start = malloc(num_fields * sizeof(Node*));
+    GameBoard* game_board = arena_alloc(arena, sizeof(GameBoard));
+    Node* gb = arena_alloc(arena, sizeof(Node) * num_fields);
+    int* jumps = arena_alloc(arena, sizeof(int) * num_fields);
+    if (!game_board || !gb || !jumps) {
+        LOG_ERROR("Memory allocation failed for game board.");
+        return NULL;
+    }
 
     // Initialize game_board with values from config
     game_board->rows = config->rows;
     game_board->cols = config->cols;
-    
-    Node** gb = game_board -> start;
-    logm(DEBUG, "create_game_board", "Initialized game board successfully.");
+    game_board->start = gb;
+    game_board->jumps = jumps;
+    LOG_DEBUG("Initialized game board successfully.");
 
-    // Initialize default board
+    // Initialize default board and mark the start of every snake and ladder
+    fill_jumps(config, jumps);
     for (int i = 0; i < num_fields; i++) {
-        gb[i] = malloc(sizeof(Node));
-        gb[i]->ft = DEFAULT;
+        gb[i].ft = DEFAULT;
     }
-    logm(DEBUG, "create_game_board", "Initialized game board with default Node* successfully.");
+    for (int j = 0; j < config->num_snakes; j++) {
+        gb[config->snakes[j].start - 1].ft = SNAKE;
+    }
+    for (int j = 0; j < config->num_ladders; j++) {
+        gb[config->ladders[j].start - 1].ft = LADDER;
+    }
+    LOG_DEBUG("Initialized game board with default Nodes successfully.");
 
-    // Include snakes and ladders and possible moves from any current position
+    // All successor arrays share one contiguous block, snakes and ladders only have a single successor
+    size_t num_successors = 0;
     for (int i = 0; i < num_fields; i++) {
-        // Check if current field is beginning of snake
-        for (int j = 0; j < config->num_snakes; j++) {
-            if (config->snakes[j].start - 1 == i) {
-                // Current field is start of snake
-                gb[i]->ft = SNAKE;
-                gb[i]->successors = malloc(sizeof(Node*));
-                gb[i]->successors[0] = gb[config->snakes[j].end - 1]; 
-            }
-        }
+        num_successors += (gb[i].ft == DEFAULT) ? config->dice_sides : 1;
+    }
+    Node** successors = arena_alloc(arena, sizeof(Node*) * num_successors);
+    if (!successors) {
+        LOG_ERROR("Memory allocation failed for successors.");
+        return NULL;
+    }
 
-        // Check if current field is beginning of ladder
-        for (int j = 0; j < config->num_ladders; j++) {
-            if (config->ladders[j].start - 1 == i) {
-                // Current field is start of ladder
-                gb[i]->ft = LADDER;
-                gb[i]->successors = malloc(sizeof(Node*));
-                gb[i]->successors[0] = gb[config->ladders[j].end - 1]; 
-            }
+    // Possible moves from any current position
+    for (int i = 0; i < num_fields; i++) {
+        gb[i].successors = successors;
+        if (gb[i].ft != DEFAULT) {
+            successors++;
+            continue;
         }
 
-        // Current field is still default
-        if (gb[i]->ft == DEFAULT) {
-            gb[i]->successors = malloc(sizeof(Node*) * config->dice_sides);
-            for (int j = 0; j < config->dice_sides; j++) {
-                if (i + j + 1 < num_fields) {
-                    gb[i]->successors[j] = gb[i + j + 1];
-                } else {
-                    gb[i]->successors[j] = gb[i];
-                }
+        for (int j = 0; j < config->dice_sides; j++) {
+            if (i + j + 1 < num_fields) {
+                successors[j] = &gb[i + j + 1];
+            } else {
+                successors[j] = &gb[i];
             }
         }
+        successors += config->dice_sides;
     }
-    logm(DEBUG, "create_game_board", "Successfully added snakes and ladders to game field.");
-    return game_board;
-}
-
-void free_board(GameBoard* game_board) {
-    if (!game_board) return;
-
-    int num_fields = game_board->rows * game_board->cols;
 
-    if (game_board->start) {
-        for (int i = 0; i < num_fields; i++) {
-            // Free possible destinations 
-            free(game_board->start[i]->successors);
-            // Free node itself
-            free(game_board->start[i]);
-        }
-        // Free the array of Node* 
-        free(game_board->start);
+    // Include snakes and ladders
+    for (int j = 0; j < config->num_snakes; j++) {
+        gb[config->snakes[j].start - 1].successors[0] = &gb[config->snakes[j].end - 1];
     }
-    // Free GameBoard itself
-    free(game_board);
-}
-
-void print_game_board(GameBoard* board) {
-    if (!board || !board->start) {
-        logm(ERROR, "print_game_board", "Invalid board or start point (NULL pointer).");
-        return;
+    for (int j = 0; j < config->num_ladders; j++) {
+        gb[config->ladders[j].start - 1].successors[0] = &gb[config->ladders[j].end - 1];
     }
-
-    puts("");
-    int num_fields = board->rows * board->cols;
-
-    for (int r = 0; r < board->rows; r++) {
-        printf("| ");
-        for (int c = 0; c < board->cols; c++) {
-            int index = r * board->cols + c;
-            Node* node = board->start[index];
-
-            printf("[%3d] ", index + 1);
-
-            switch (node->ft) {
-                case SNAKE:
-                    for (int i = 0; i < num_fields; i++) {
-                        if (board->start[i] == node->successors[0]) {
-                            printf(SNAKECOL "S -> %3d" RESET, i + 1);
-                            break;
-                        }
-                    }
-                    break;
-                case LADDER:
-                    for (int i = 0; i < num_fields; i++) {
-                        if (board->start[i] == node->successors[0]) {
-                            printf(LADDERCOL "L -> %3d" RESET, i + 1);
-                            break;
-                        }
-                    }
-                    break;
-                default:
-                    printf("N       ");
-                    break;
-            }
-            printf(" | ");
-        }
-        puts("");
-    }
-    puts("");
-}
\ No newline at end of file
+    LOG_DEBUG("Successfully added snakes and ladders to game field.");
+    return game_board;
+}
@@ -1,6 +1,7 @@
 #pragma once
 #include "logger.h"
 #include "config_manager.h"
+#include "arena.h"
 
 typedef enum {
     SNAKE, LADDER, DEFAULT
@@ -14,38 +15,34 @@ typedef struct Node {
 typedef struct {
     int rows;
     int cols;
-    Node** start;
+    Node* start;
+    int* jumps;     // Per square: 0-based index the player ends up on after landing there (itself if no snake or ladder)
 } GameBoard;
 
 /**
- * @brief Creates and initializes a new game board based on the given configuration.
+ * @brief Fills the jump table of a configuration, the index representation shared by the board, the simulation
+ * and the exact solver.
  *
- * This function allocates and initializes a `GameBoard` structure with a grid of `Node` elements
- * representing the fields of the game. Each node is initialized with its appropriate type
- * (`DEFAULT`, `SNAKE`, or `LADDER`), and sets up successor pointers for dice moves, ladders, or snakes.
+ * `jumps[i]` is the 0-based index of the square the player ends up on after landing on square `i` (0-based),
+ * which is `i` itself if no snake or ladder starts there.
  *
- * @param config Pointer to the configuration structure containing board dimensions, dice sides, snakes, and ladders.
- * @return Pointer to the dynamically allocated `GameBoard`. Must be freed using `free_board`.
+ * @param config Pointer to the configuration containing board dimensions, snakes, and ladders.
+ * @param jumps Array with one entry per square.
  */
-GameBoard* create_game_board(Config* config);
+void fill_jumps(Config* config, int* jumps);
 
 /**
- * @brief Frees the memory associated with a game board.
+ * @brief Creates and initializes a new game board based on the given configuration.
  *
- * This function safely deallocates all memory allocated by `create_game_board`,
- * including all `Node` structures and their successor arrays.
+ * This function allocates and initializes a `GameBoard` structure with a contiguous array of `Node` elements
+ * representing the fields of the game. Each node is initialized with its appropriate type
+ * (`DEFAULT`, `SNAKE`, or `LADDER`), and sets up successor pointers for dice moves, ladders, or snakes.
+ * All successor arrays are laid out in a single block. Snake and ladder destinations are additionally stored as
+ * square indices in `jumps`, so they can be looked up without following node pointers.
  *
- * @param board Pointer to the `GameBoard` to be deallocated. If NULL, the function does nothing.
+ * @param config Pointer to the configuration structure containing board dimensions, dice sides, snakes, and ladders.
+ * @param arena Pointer to the arena that owns the board, it is released together with the arena.
+ * @return Pointer to the `GameBoard`, or NULL if memory allocation fails.
  */
-void free_board(GameBoard* board);
+GameBoard* create_game_board(Config* config, Arena* arena);
 
-/**
- * @brief Prints a formatted representation of the game board to the console.
- *
- * Displays each field in the board, indicating whether it is a normal node (`N`),
- * a snake (`S -> X`), or a ladder (`L -> X`) and its corresponding destination.
- * Output is formatted as a grid according to the board's row and column configuration.
- *
- * @param board Pointer to the `GameBoard` to be printed. If NULL or uninitialized, the function does nothing.
- */
-void print_game_board(GameBoard* board);
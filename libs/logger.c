@@ -1,27 +1,126 @@
+#define _POSIX_C_SOURCE 200809L
 #include "logger.h"
 #include <stdio.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
 
 #define RED "\033[1;31m"  // ERROR color
 #define BLUE "\033[1;34m" // DEBUG color
 #define YELLOW "\033[1;33m" // INFO color
 #define RESET "\033[0m"   // Reset color
-#define DEBUG_MODE 0
-
-void logm(LogLevel log_level, char* function_name, char* message) {
-    switch (log_level) {
-        case INFO:
-            printf(YELLOW "[INFO] - %s() : %s\n" RESET, function_name, message);
-            break;
-        case DEBUG:
-            if (DEBUG_MODE) {
-                printf(BLUE "[DEBUG] - %s() : %s\n" RESET, function_name, message);
-            }
-            break;
-        case ERROR:
-            printf(RED "[ERROR] - %s() : %s\n" RESET, function_name, message);
-            break;
-        default:
-            logm(ERROR, "log", "Invalid log level!");
-            break;
+
+typedef struct {
+    const char* format;
+    const char* function_name;
+    LogLevel log_level;
+    int count;
+} LogSite;
+
+LogLevel log_threshold = INFO;
+
+static pthread_mutex_t log_mutex = PTHREAD_MUTEX_INITIALIZER;
+static LogSite log_sites[LOG_MAX_SITES];
+static int num_log_sites = 0;
+static char log_buffer[LOG_BUFFER_SIZE];
+static int log_immediate = 0;
+static int log_level_locked = 0;
+
+static const char* LEVEL_NAMES[] = { "ERROR", "INFO", "DEBUG" };
+static const char* LEVEL_COLORS[] = { RED, YELLOW, BLUE };
+
+void log_init(LogLevel log_level) {
+    set_log_level(log_level);
+    setvbuf(stderr, log_buffer, _IOFBF, LOG_BUFFER_SIZE);
+    // Someone is watching the terminal, deferring output would only delay it
+    log_immediate = isatty(fileno(stderr));
+    atexit(log_flush);
+}
+
+void set_log_level(LogLevel log_level) {
+    if (log_level < ERROR || log_level > DEBUG) {
+        LOG_ERROR("Invalid log level %d!", (int) log_level);
+        return;
+    }
+    if (log_level_locked) return;
+    log_threshold = log_level;
+}
+
+void lock_log_level(void) {
+    log_level_locked = 1;
+}
+
+void set_log_immediate(int immediate) {
+    pthread_mutex_lock(&log_mutex);
+    log_immediate = immediate;
+    if (immediate) fflush(stderr);
+    pthread_mutex_unlock(&log_mutex);
+}
+
+int parse_log_level(const char* name, LogLevel* log_level) {
+    for (int i = ERROR; i <= DEBUG; i++) {
+        if (strcmp(name, LEVEL_NAMES[i]) == 0) {
+            *log_level = (LogLevel) i;
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Counts an occurrence of a message and returns whether it should still be printed.
+ *
+ * Messages are identified by their format string, so the same message with different values counts as a
+ * repetition. Must be called with `log_mutex` held.
+ */
+static int count_occurrence(LogLevel log_level, const char* function_name, const char* format) {
+    for (int i = 0; i < num_log_sites; i++) {
+        if (log_sites[i].format == format) {
+            return ++log_sites[i].count <= LOG_REPEAT_LIMIT;
+        }
+    }
+
+    if (num_log_sites < LOG_MAX_SITES) {
+        log_sites[num_log_sites++] = (LogSite) { format, function_name, log_level, 1 };
+    }
+    return 1;
+}
+
+void logm(LogLevel log_level, const char* function_name, const char* format, ...) {
+    if (log_level < ERROR || log_level > DEBUG) {
+        LOG_ERROR("Invalid log level %d!", (int) log_level);
+        return;
+    }
+    if (log_level > log_threshold) return;
+
+    pthread_mutex_lock(&log_mutex);
+    if (log_level == ERROR || count_occurrence(log_level, function_name, format)) {
+        va_list args;
+        va_start(args, format);
+        fprintf(stderr, "%s[%s] - %s() : ", LEVEL_COLORS[log_level], LEVEL_NAMES[log_level], function_name);
+        vfprintf(stderr, format, args);
+        fputs("\n" RESET, stderr);
+        va_end(args);
+
+        if (log_level == ERROR || log_immediate) fflush(stderr);
+    }
+    pthread_mutex_unlock(&log_mutex);
+}
+
+void log_flush(void) {
+    pthread_mutex_lock(&log_mutex);
+    for (int i = 0; i < num_log_sites; i++) {
+        LogSite* site = &log_sites[i];
+        // Messages counted before the level was raised are not summarized either
+        if (site->count > LOG_REPEAT_LIMIT && site->log_level <= log_threshold) {
+            fprintf(stderr, "%s[%s] - %s() : %d similar messages suppressed.\n" RESET,
+                LEVEL_COLORS[site->log_level], LEVEL_NAMES[site->log_level], site->function_name,
+                site->count - LOG_REPEAT_LIMIT);
+        }
+        site->count = 0;
     }
-}
\ No newline at end of file
+    fflush(stderr);
+    pthread_mutex_unlock(&log_mutex);
+}
@@ -4,19 +4,105 @@ typedef enum {
     ERROR, INFO, DEBUG
 } LogLevel;
 
+// Most verbose level that is compiled in, messages above it are removed by the compiler (e.g. -DLOG_COMPILE_LEVEL=INFO)
+#ifndef LOG_COMPILE_LEVEL
+#define LOG_COMPILE_LEVEL DEBUG
+#endif
+
+// Number of times the same INFO or DEBUG message is printed before further repetitions are only counted
+#define LOG_REPEAT_LIMIT 3
+// Number of distinct messages the repetition counter keeps track of
+#define LOG_MAX_SITES 128
+// Size of the stderr output buffer
+#define LOG_BUFFER_SIZE 8192
+
+// Current runtime log level, use `set_log_level` to change it
+extern LogLevel log_threshold;
+
 /**
- * @brief Logs a message to the console with colored output based on log level.
+ * @brief Logs a printf-style message if its level is compiled in and enabled at runtime.
  *
- * Prints a formatted message to the standard output or error stream, including function name and the log message.
- * Colored output is used to distinguish between `INFO`, `DEBUG`, and `ERROR` levels. `DEBUG` logs are only printed
- * if `DEBUG_MODE` is set to 1.
+ * The level checks are done before any argument is evaluated, so disabled messages cost a single comparison
+ * and messages above `LOG_COMPILE_LEVEL` are removed at compile time. The name of the calling function is
+ * added automatically.
+ */
+#define LOG_AT(level, ...) \
+    do { \
+        if (LOG_COMPILE_LEVEL >= (level) && (level) <= log_threshold) logm((level), __func__, __VA_ARGS__); \
+    } while (0)
+
+#define LOG_ERROR(...) LOG_AT(ERROR, __VA_ARGS__)
+#define LOG_INFO(...) LOG_AT(INFO, __VA_ARGS__)
+#define LOG_DEBUG(...) LOG_AT(DEBUG, __VA_ARGS__)
+
+/**
+ * @brief Initializes the logger with a runtime log level.
+ *
+ * Switches stderr to a fully buffered stream of `LOG_BUFFER_SIZE` bytes and registers `log_flush` to run
+ * at exit. If stderr is a terminal, every message is still flushed immediately (see `set_log_immediate`).
+ * Must be called before anything is written to stderr.
+ *
+ * @param log_level The most verbose level that should be printed.
+ */
+void log_init(LogLevel log_level);
+
+/**
+ * @brief Changes the runtime log level.
+ *
+ * @param log_level The most verbose level that should be printed.
+ */
+void set_log_level(LogLevel log_level);
+
+/**
+ * @brief Keeps the current log level, later calls to `set_log_level` (e.g. from `LOG_LEVEL=` in a
+ * configuration file) have no effect. Used when the level was given on the command line.
+ */
+void lock_log_level(void);
+
+/**
+ * @brief Selects whether every message is flushed as soon as it is logged.
+ *
+ * Interactive modes (e.g. edit sessions and the server) enable this so that messages are not held back until
+ * the buffer fills up or the program exits. Batch runs leave it disabled and only flush on `ERROR`.
+ *
+ * @param immediate `1` to flush after every message, `0` to buffer messages.
+ */
+void set_log_immediate(int immediate);
+
+/**
+ * @brief Parses a log level name (`ERROR`, `INFO` or `DEBUG`, case sensitive).
+ *
+ * @param name The name of the level.
+ * @param log_level Pointer that receives the parsed level.
+ * @return int Returns `0` on success, `1` if the name is unknown.
+ */
+int parse_log_level(const char* name, LogLevel* log_level);
+
+/**
+ * @brief Logs a printf-style message to stderr with colored output based on log level.
+ *
+ * Prints a formatted message including function name and the log message. Colored output is used to distinguish
+ * between `INFO`, `DEBUG`, and `ERROR` levels. Messages above the runtime log level are dropped. After the same
+ * `INFO` or `DEBUG` message (identified by its format string) was printed `LOG_REPEAT_LIMIT` times, further
+ * repetitions are only counted and summarized by `log_flush`. `ERROR` messages are never suppressed and flush
+ * the output buffer immediately, other messages only if `set_log_immediate` is enabled.
+ *
+ * Prefer the `LOG_ERROR`, `LOG_INFO` and `LOG_DEBUG` macros, which skip the call entirely for disabled levels.
  *
  * @param log_level The severity level of the message (`INFO`, `DEBUG`, or `ERROR`).
  * @param function_name The name of the function where the log is generated.
- * @param message The log message to be displayed.
+ * @param format printf-style format string of the message, followed by its arguments.
  *
  * @note Uses ANSI escape codes for coloring; may not work properly on all terminals.
- * @note If an invalid log level is passed, it recursively logs an error about the invalid level.
+ * @note Thread-safe.
  */
-void logm(LogLevel log_level, char* function_name, char* message);
+void logm(LogLevel log_level, const char* function_name, const char* format, ...) __attribute__((format(printf, 3, 4)));
 
+/**
+ * @brief Ends the current scope of repeated messages and flushes stderr.
+ *
+ * Prints how many repeated messages were suppressed since the last flush (only for levels that are still
+ * enabled) and resets the repetition counters, so the next batch (e.g. the next parsed file or edit command)
+ * starts printing again. Also runs at exit.
+ */
+void log_flush(void);
@@ -0,0 +1,255 @@
+#include "markov.h"
+#include <string.h>
+#include <math.h>
+
+#define MARKOV_EPSILON 1e-12
+
+/**
+ * @brief Returns the state a snake or ladder on square `state` leads to, or 0 if there is none.
+ *
+ * States are 1-based squares while the jump table is indexed by 0-based squares.
+ */
+static int jump_target(MarkovSolver* solver, int state) {
+    int square = state - 1;
+    return (state > 0 && solver->jumps[square] != square) ? solver->jumps[square] + 1 : 0;
+}
+
+/**
+ * @brief Writes row `state` of the matrix `I - Q` into `row` and returns the roll cost of the state.
+ *
+ * State 0 is the start position in front of the board, state `i` is square `i`. The last square is
+ * absorbing and therefore has no column. Squares with a snake or ladder forward to their destination
+ * without costing a roll.
+ */
+static double build_row(MarkovSolver* solver, int state, double* row) {
+    const int n = solver->num_fields;
+    memset(row, 0, sizeof(double) * n);
+    row[state] = 1.0;
+
+    int jump = jump_target(solver, state);
+    if (jump) {
+        if (jump < n) {
+            row[jump] -= 1.0;
+        }
+        return 0.0;
+    }
+
+    // Rolls overshooting the last square are retried without counting if overshooting is not allowed
+    int valid_rolls = solver->dice_sides;
+    if (!solver->allow_overshoot && n - state < valid_rolls) {
+        valid_rolls = n - state;
+    }
+
+    for (int roll = 1; roll <= solver->dice_sides; roll++) {
+        int target = state + roll;
+        if (target >= n) continue; // absorbed or retried
+        row[target] -= 1.0 / valid_rolls;
+    }
+    return 1.0;
+}
+
+/**
+ * @brief Inverts `I - Q` from scratch using Gauss-Jordan elimination with partial pivoting.
+ *
+ * Leaves `solver->solved` at 0 if the matrix is singular, which happens if the last square
+ * cannot be reached from every square.
+ */
+static void full_solve(MarkovSolver* solver) {
+    const int n = solver->num_fields;
+    double* a = solver->work;
+    double* inv = solver->fundamental;
+    solver->solved = 0;
+    solver->updates_since_solve = 0;
+
+    memset(inv, 0, sizeof(double) * n * n);
+    for (int i = 0; i < n; i++) {
+        build_row(solver, i, a + (size_t) i * n);
+        inv[(size_t) i * n + i] = 1.0;
+    }
+
+    for (int col = 0; col < n; col++) {
+        // Find pivot
+        int pivot = col;
+        for (int r = col + 1; r < n; r++) {
+            if (fabs(a[(size_t) r * n + col]) > fabs(a[(size_t) pivot * n + col])) pivot = r;
+        }
+        if (fabs(a[(size_t) pivot * n + col]) < MARKOV_EPSILON) {
+            LOG_INFO("The last square is not reachable from every square, expected rolls are infinite.");
+            return;
+        }
+
+        if (pivot != col) {
+            for (int k = 0; k < n; k++) {
+                double tmp = a[(size_t) col * n + k];
+                a[(size_t) col * n + k] = a[(size_t) pivot * n + k];
+                a[(size_t) pivot * n + k] = tmp;
+                tmp = inv[(size_t) col * n + k];
+                inv[(size_t) col * n + k] = inv[(size_t) pivot * n + k];
+                inv[(size_t) pivot * n + k] = tmp;
+            }
+        }
+
+        double scale = 1.0 / a[(size_t) col * n + col];
+        for (int k = 0; k < n; k++) {
+            a[(size_t) col * n + k] *= scale;
+            inv[(size_t) col * n + k] *= scale;
+        }
+
+        for (int r = 0; r < n; r++) {
+            double factor = a[(size_t) r * n + col];
+            if (r == col || factor == 0.0) continue;
+            for (int k = 0; k < n; k++) {
+                a[(size_t) r * n + k] -= factor * a[(size_t) col * n + k];
+                inv[(size_t) r * n + k] -= factor * inv[(size_t) col * n + k];
+            }
+        }
+    }
+
+    solver->solved = 1;
+}
+
+/**
+ * @brief Recomputes expected rolls from the fundamental matrix and the abort probability by
+ * propagating the position distribution for `max_simulation_steps - 1` rolls.
+ */
+static void update_statistics(MarkovSolver* solver) {
+    const int n = solver->num_fields;
+
+    if (solver->solved) {
+        // Expected rolls from the start state = row 0 of (I - Q)^-1 times the roll cost vector
+        double expected = 0.0;
+        for (int j = 0; j < n; j++) {
+            if (!jump_target(solver, j)) expected += solver->fundamental[j];
+        }
+        solver->expected_rolls = expected;
+    } else {
+        solver->expected_rolls = INFINITY;
+    }
+
+    double* current = solver->row_a;
+    double* next = solver->row_b;
+    memset(current, 0, sizeof(double) * n);
+    current[0] = 1.0;
+    double remaining = 1.0;
+    const double p = 1.0 / solver->dice_sides;
+
+    // run_sim aborts as soon as the step counter reaches max_simulation_steps
+    for (int step = 1; step < solver->max_simulation_steps && remaining > MARKOV_EPSILON; step++) {
+        memset(next, 0, sizeof(double) * n);
+        for (int i = 0; i < n; i++) {
+            if (current[i] == 0.0) continue;
+            for (int roll = 1; roll <= solver->dice_sides; roll++) {
+                int target = i + roll;
+                if (target > n && !solver->allow_overshoot) {
+                    // Roll is spent without moving
+                    next[i] += current[i] * p;
+                    continue;
+                }
+                if (target >= n) continue;
+                int jump = jump_target(solver, target);
+                if (jump) target = jump;
+                if (target >= n) continue;
+                next[target] += current[i] * p;
+            }
+        }
+
+        remaining = 0.0;
+        for (int i = 0; i < n; i++) remaining += next[i];
+
+        double* tmp = current;
+        current = next;
+        next = tmp;
+    }
+
+    solver->abort_probability = remaining;
+}
+
+MarkovSolver* create_markov_solver(Config* config, Arena* arena) {
+    if (!config || !arena) {
+        LOG_ERROR("Invalid Config or Arena (NULL pointer).");
+        return NULL;
+    }
+
+    const int num_fields = config->rows * config->cols;
+    if (num_fields > MARKOV_MAX_FIELDS) {
+        LOG_ERROR("Board with %d squares is too large for the exact solver (max %d).", num_fields, MARKOV_MAX_FIELDS);
+        return NULL;
+    }
+
+    // All matrices and work rows are allocated once, edits do not allocate
+    MarkovSolver* solver = arena_alloc(arena, sizeof(MarkovSolver));
+    if (!solver) {
+        LOG_ERROR("Memory allocation failed for MarkovSolver.");
+        return NULL;
+    }
+    solver->num_fields = num_fields;
+    solver->dice_sides = config->dice_sides;
+    solver->allow_overshoot = config->allow_overshoot;
+    solver->max_simulation_steps = config->max_simulation_steps;
+    solver->solved = 0;
+    solver->updates_since_solve = 0;
+
+    solver->jumps = arena_alloc(arena, sizeof(int) * num_fields);
+    solver->fundamental = arena_alloc(arena, sizeof(double) * num_fields * num_fields);
+    solver->work = arena_alloc(arena, sizeof(double) * num_fields * num_fields);
+    solver->row_a = arena_alloc(arena, sizeof(double) * num_fields);
+    solver->row_b = arena_alloc(arena, sizeof(double) * num_fields);
+    if (!solver->jumps || !solver->fundamental || !solver->work || !solver->row_a || !solver->row_b) {
+        LOG_ERROR("Memory allocation failed for solver matrices.");
+        return NULL;
+    }
+
+    fill_jumps(config, solver->jumps);
+
+    full_solve(solver);
+    update_statistics(solver);
+    LOG_DEBUG("Solved absorbing chain successfully.");
+    return solver;
+}
+
+void markov_set_transition(MarkovSolver* solver, int start, int end) {
+    if (!solver || start <= 0 || start >= solver->num_fields) {
+        LOG_ERROR("Invalid solver or square %d.", start);
+        return;
+    }
+
+    const int n = solver->num_fields;
+    double* old_row = solver->row_a;
+    double* diff = solver->row_b;
+
+    build_row(solver, start, old_row);
+    solver->jumps[start - 1] = end ? end - 1 : start - 1;
+    build_row(solver, start, diff);
+    for (int k = 0; k < n; k++) diff[k] -= old_row[k];
+
+    double* f = solver->fundamental;
+    int need_full_solve = !solver->solved || ++solver->updates_since_solve >= MARKOV_REFRESH_INTERVAL;
+
+    if (!need_full_solve) {
+        // Sherman-Morrison: (A + e_s d^T)^-1 = F - (F e_s)(d^T F) / (1 + d^T F e_s)
+        double denom = 1.0;
+        for (int k = 0; k < n; k++) {
+            if (diff[k] != 0.0) denom += diff[k] * f[(size_t) k * n + start];
+        }
+
+        if (fabs(denom) < MARKOV_EPSILON) {
+            need_full_solve = 1;
+        } else {
+            // old_row is reused to hold d^T F
+            memset(old_row, 0, sizeof(double) * n);
+            for (int k = 0; k < n; k++) {
+                if (diff[k] == 0.0) continue;
+                for (int j = 0; j < n; j++) old_row[j] += diff[k] * f[(size_t) k * n + j];
+            }
+
+            for (int i = 0; i < n; i++) {
+                double factor = f[(size_t) i * n + start] / denom;
+                if (factor == 0.0) continue;
+                for (int j = 0; j < n; j++) f[(size_t) i * n + j] -= factor * old_row[j];
+            }
+        }
+    }
+
+    if (need_full_solve) full_solve(solver);
+    update_statistics(solver);
+}
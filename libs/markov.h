@@ -0,0 +1,57 @@
+#pragma once
+#include "config_manager.h"
+#include "arena.h"
+#include "game_board.h"
+
+// Largest board (in squares) the exact solver accepts, the fundamental matrix is stored densely
+#define MARKOV_MAX_FIELDS 2048
+// Number of incremental updates after which the fundamental matrix is recomputed to limit rounding drift
+#define MARKOV_REFRESH_INTERVAL 64
+
+typedef struct {
+    int num_fields;
+    int dice_sides;
+    int allow_overshoot;
+    int max_simulation_steps;
+    int* jumps;                 // Jump table of the board, see `fill_jumps`
+    double* fundamental;
+    double* work;
+    double* row_a;
+    double* row_b;
+    int solved;
+    int updates_since_solve;
+    double expected_rolls;
+    double abort_probability;
+} MarkovSolver;
+
+/**
+ * @brief Creates an exact solver for the absorbing Markov chain described by a configuration.
+ *
+ * Every square except the last one is a transient state, with an additional state for the start position
+ * in front of the board. The solver computes the fundamental matrix `(I - Q)^-1` once and derives the
+ * expected number of rolls to win and the probability of a game being aborted after `max_simulation_steps`.
+ * Rolls that overshoot the last square without `allow_overshoot` are not counted as rolls, which mirrors
+ * how `run_sim` counts them.
+ *
+ * @param config Pointer to the configuration containing board size, dice, snakes and ladders.
+ * @param arena Pointer to the arena that owns the solver and all of its matrices.
+ * @return Pointer to the `MarkovSolver`, or NULL if the board is too large (see `MARKOV_MAX_FIELDS`)
+ *         or memory allocation fails.
+ */
+MarkovSolver* create_markov_solver(Config* config, Arena* arena);
+
+/**
+ * @brief Places, moves or removes a snake or ladder and updates the exact solution incrementally.
+ *
+ * Changing the transition starting on one square only changes one row of `I - Q`, so the fundamental
+ * matrix is updated with a rank-one Sherman-Morrison correction in O(squares^2) instead of being inverted
+ * again. A full solve is only done when the update is numerically unstable or after
+ * `MARKOV_REFRESH_INTERVAL` updates. The abort probability is recomputed afterwards.
+ *
+ * @param solver Pointer to an initialized `MarkovSolver`.
+ * @param start The square (1-based) the snake or ladder starts on.
+ * @param end The square (1-based) the snake or ladder leads to, or `0` to remove the transition.
+ *
+ * @note The transition is not validated, use `validate_transition` before calling this function.
+ */
+void markov_set_transition(MarkovSolver* solver, int start, int end);
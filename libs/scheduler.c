@@ -0,0 +1,298 @@
+#define _GNU_SOURCE
+#include "scheduler.h"
+#include "logger.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sched.h>
+#include <unistd.h>
+
+double wall_time(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**
+ * @brief Grows a worker's deque until `extra` more tasks fit. Must be called with the worker's lock held.
+ */
+static int reserve_tasks(Worker* worker, int extra) {
+    int capacity = worker->capacity;
+    while (capacity - worker->count < extra) capacity *= 2;
+    if (capacity == worker->capacity) return 0;
+
+    Task* tasks = malloc(sizeof(Task) * capacity);
+    if (!tasks) return 1;
+    for (int i = 0; i < worker->count; i++) {
+        tasks[i] = worker->tasks[(worker->top + i) % worker->capacity];
+    }
+    free(worker->tasks);
+    worker->tasks = tasks;
+    worker->top = 0;
+    worker->capacity = capacity;
+    return 0;
+}
+
+/**
+ * @brief Pushes a task to the bottom of a worker's deque. Capacity must have been reserved, lock held.
+ */
+static void push_task(Worker* worker, Task task) {
+    worker->tasks[(worker->top + worker->count) % worker->capacity] = task;
+    worker->count++;
+}
+
+/**
+ * @brief Takes a task from a worker's deque.
+ *
+ * Thieves always take the top (oldest) task. The owner takes the bottom task only if it belongs to the group
+ * it is currently running (LIFO within a group keeps its data warm) and the oldest task otherwise (FIFO
+ * between independent groups).
+ *
+ * @return 1 if a task was taken; 0 if the deque is empty.
+ */
+static int take_task(Worker* worker, int is_thief, TaskGroup* current_group, Task* task) {
+    pthread_mutex_lock(&worker->lock);
+    if (worker->count == 0) {
+        pthread_mutex_unlock(&worker->lock);
+        return 0;
+    }
+    int bottom = (worker->top + worker->count - 1) % worker->capacity;
+    if (is_thief || worker->tasks[bottom].group != current_group) {
+        *task = worker->tasks[worker->top];
+        worker->top = (worker->top + 1) % worker->capacity;
+    } else {
+        *task = worker->tasks[bottom];
+    }
+    worker->count--;
+    pthread_mutex_unlock(&worker->lock);
+    return 1;
+}
+
+/**
+ * @brief Finds the next task for a worker, first from its own deque and then from the others.
+ */
+static int find_task(Worker* worker, Task* task) {
+    Scheduler* scheduler = worker->scheduler;
+    if (take_task(worker, 0, worker->current_group, task)) return 1;
+
+    for (int i = 1; i < scheduler->num_workers; i++) {
+        Worker* victim = &scheduler->workers[(worker->id + i) % scheduler->num_workers];
+        if (take_task(victim, 1, NULL, task)) {
+            atomic_fetch_add(&worker->tasks_stolen, 1);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void* worker_loop(void* arg) {
+    Worker* worker = arg;
+    Scheduler* scheduler = worker->scheduler;
+
+    if (worker->cpu >= 0) {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(worker->cpu, &cpus);
+        if (pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) != 0) {
+            LOG_INFO("Could not pin worker %d to CPU %d.", worker->id, worker->cpu);
+        }
+    }
+
+    // Wait until every worker thread was started, the number of workers to steal from is final afterwards
+    pthread_mutex_lock(&scheduler->idle_lock);
+    while (!scheduler->running && !scheduler->shutdown) {
+        pthread_cond_wait(&scheduler->work_available, &scheduler->idle_lock);
+    }
+    pthread_mutex_unlock(&scheduler->idle_lock);
+
+    while (1) {
+        Task task;
+        if (find_task(worker, &task)) {
+            atomic_fetch_sub(&scheduler->pending_tasks, 1);
+
+            double start = wall_time();
+            TaskGroup* group = task.group;
+            worker->current_group = group;
+            group->function(group->arg, task.begin, task.end, worker->id);
+            // Statistics are written before the chunk is counted as done, so whoever observes the group's
+            // completion also observes them
+            atomic_store(&worker->busy_time, atomic_load(&worker->busy_time) + wall_time() - start);
+            atomic_fetch_add(&worker->tasks_run, 1);
+
+            // Only the worker finishing the last chunk may touch the group afterwards
+            if (atomic_fetch_sub(&group->remaining, 1) == 1 && group->on_complete) {
+                group->on_complete(group->callback_arg);
+            }
+            continue;
+        }
+
+        pthread_mutex_lock(&scheduler->idle_lock);
+        while (atomic_load(&scheduler->pending_tasks) == 0 && !scheduler->shutdown) {
+            pthread_cond_wait(&scheduler->work_available, &scheduler->idle_lock);
+        }
+        int done = scheduler->shutdown && atomic_load(&scheduler->pending_tasks) == 0;
+        pthread_mutex_unlock(&scheduler->idle_lock);
+        if (done) return NULL;
+    }
+}
+
+/**
+ * @brief Returns the `n`-th CPU (modulo their number) of a set of allowed CPUs.
+ */
+static int nth_cpu(cpu_set_t* allowed, int num_allowed, int n) {
+    n %= num_allowed;
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if (CPU_ISSET(cpu, allowed) && n-- == 0) return cpu;
+    }
+    return -1;
+}
+
+Scheduler* create_scheduler(int num_workers, int pin_threads) {
+    // Respect the CPUs the process may run on (e.g. taskset or cpusets), not every online CPU
+    cpu_set_t allowed;
+    int num_allowed = 0;
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0) {
+        num_allowed = CPU_COUNT(&allowed);
+    }
+    if (num_allowed <= 0) {
+        long num_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        num_allowed = num_cpus > 0 ? (int) num_cpus : 1;
+        CPU_ZERO(&allowed);
+        for (int cpu = 0; cpu < num_allowed && cpu < CPU_SETSIZE; cpu++) CPU_SET(cpu, &allowed);
+    }
+    if (num_workers <= 0) num_workers = num_allowed;
+
+    Scheduler* scheduler = calloc(1, sizeof(Scheduler));
+    Worker* workers = calloc(num_workers, sizeof(Worker));
+    if (!scheduler || !workers) {
+        LOG_ERROR("Memory allocation failed for scheduler.");
+        free(scheduler);
+        free(workers);
+        return NULL;
+    }
+
+    scheduler->num_workers = num_workers;
+    scheduler->workers = workers;
+    scheduler->start_time = wall_time();
+    atomic_init(&scheduler->pending_tasks, 0);
+    atomic_init(&scheduler->next_worker, 0);
+    pthread_mutex_init(&scheduler->idle_lock, NULL);
+    pthread_cond_init(&scheduler->work_available, NULL);
+
+    for (int i = 0; i < num_workers; i++) {
+        workers[i].scheduler = scheduler;
+        workers[i].id = i;
+        workers[i].cpu = pin_threads ? nth_cpu(&allowed, num_allowed, i) : -1;
+        workers[i].capacity = SCHEDULER_DEQUE_CAPACITY;
+        workers[i].tasks = malloc(sizeof(Task) * SCHEDULER_DEQUE_CAPACITY);
+        pthread_mutex_init(&workers[i].lock, NULL);
+        if (!workers[i].tasks) {
+            LOG_ERROR("Memory allocation failed for worker deque.");
+            scheduler->num_workers = i + 1;
+            destroy_scheduler(scheduler);
+            return NULL;
+        }
+    }
+
+    for (; scheduler->num_started < num_workers; scheduler->num_started++) {
+        Worker* worker = &workers[scheduler->num_started];
+        if (pthread_create(&worker->thread, NULL, worker_loop, worker) != 0) break;
+    }
+    if (scheduler->num_started == 0) {
+        LOG_ERROR("Could not start any worker thread.");
+        destroy_scheduler(scheduler);
+        return NULL;
+    }
+    // Tasks are only handed to running workers, the others would never pick them up
+    for (int i = scheduler->num_started; i < num_workers; i++) {
+        free(workers[i].tasks);
+        pthread_mutex_destroy(&workers[i].lock);
+    }
+
+    pthread_mutex_lock(&scheduler->idle_lock);
+    scheduler->num_workers = scheduler->num_started;
+    scheduler->running = 1;
+    pthread_cond_broadcast(&scheduler->work_available);
+    pthread_mutex_unlock(&scheduler->idle_lock);
+
+    LOG_DEBUG("Started scheduler with %d workers%s.", scheduler->num_workers, pin_threads ? " pinned to CPUs" : "");
+    return scheduler;
+}
+
+void destroy_scheduler(Scheduler* scheduler) {
+    if (!scheduler) return;
+
+    pthread_mutex_lock(&scheduler->idle_lock);
+    scheduler->shutdown = 1;
+    pthread_cond_broadcast(&scheduler->work_available);
+    pthread_mutex_unlock(&scheduler->idle_lock);
+
+    for (int i = 0; i < scheduler->num_started; i++) {
+        pthread_join(scheduler->workers[i].thread, NULL);
+    }
+
+    for (int i = 0; scheduler->workers && i < scheduler->num_workers; i++) {
+        free(scheduler->workers[i].tasks);
+        pthread_mutex_destroy(&scheduler->workers[i].lock);
+    }
+    pthread_cond_destroy(&scheduler->work_available);
+    pthread_mutex_destroy(&scheduler->idle_lock);
+    free(scheduler->workers);
+    free(scheduler);
+}
+
+int scheduler_submit(Scheduler* scheduler, TaskGroup* group, int count, int chunk_size) {
+    if (!scheduler || !group || count <= 0 || chunk_size <= 0) {
+        LOG_ERROR("Invalid scheduler, task group or chunking.");
+        return 1;
+    }
+
+    const int num_workers = scheduler->num_workers;
+    int num_tasks = (count + chunk_size - 1) / chunk_size;
+    atomic_init(&group->remaining, num_tasks);
+
+    // Either every chunk is queued or none is: all deques are locked (in order, workers only ever hold one
+    // lock) and grown before the first chunk becomes visible
+    for (int w = 0; w < num_workers; w++) pthread_mutex_lock(&scheduler->workers[w].lock);
+    unsigned offset = atomic_fetch_add(&scheduler->next_worker, 1);
+    int failed = 0;
+    for (int w = 0; w < num_workers && !failed; w++) {
+        // Round-robin hands every worker at most this many chunks
+        failed = reserve_tasks(&scheduler->workers[w], num_tasks / num_workers + 1);
+    }
+    if (!failed) {
+        // Spread chunks round-robin, starting at a different worker for every group
+        atomic_fetch_add(&scheduler->pending_tasks, num_tasks);
+        for (int i = 0; i < num_tasks; i++) {
+            Task task = { group, i * chunk_size, (i + 1) * chunk_size < count ? (i + 1) * chunk_size : count };
+            push_task(&scheduler->workers[(offset + i) % num_workers], task);
+        }
+    }
+    for (int w = num_workers - 1; w >= 0; w--) pthread_mutex_unlock(&scheduler->workers[w].lock);
+    if (failed) {
+        LOG_ERROR("Memory allocation failed for task deque.");
+        return 1;
+    }
+
+    pthread_mutex_lock(&scheduler->idle_lock);
+    pthread_cond_broadcast(&scheduler->work_available);
+    pthread_mutex_unlock(&scheduler->idle_lock);
+    return 0;
+}
+
+void print_scheduler_stats(Scheduler* scheduler, FILE* out) {
+    if (!scheduler || !out) {
+        LOG_ERROR("Invalid scheduler or stream (NULL pointer).");
+        return;
+    }
+
+    double elapsed = wall_time() - scheduler->start_time;
+    fprintf(out, "\nScheduler Utilization (%d workers, %.3f seconds):\n", scheduler->num_workers, elapsed);
+    for (int i = 0; i < scheduler->num_workers; i++) {
+        Worker* worker = &scheduler->workers[i];
+        double busy_time = atomic_load(&worker->busy_time);
+        fprintf(out, "  - Worker %3d:  %6ld tasks (%5ld stolen)  busy %8.3f s  (%.2f%%)\n",
+            i, atomic_load(&worker->tasks_run), atomic_load(&worker->tasks_stolen), busy_time,
+            elapsed > 0 ? busy_time / elapsed * 100 : 0.0);
+    }
+}
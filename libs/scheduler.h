@@ -0,0 +1,119 @@
+#pragma once
+#include <stdio.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+// Initial number of tasks a worker deque can hold, deques grow on demand
+#define SCHEDULER_DEQUE_CAPACITY 256
+
+/**
+ * @brief Function executed for one chunk `[begin, end)` of a task group on worker `worker`.
+ */
+typedef void (*TaskFunction)(void* arg, int begin, int end, int worker);
+
+/**
+ * @brief Function called once after every chunk of a task group has been executed.
+ */
+typedef void (*GroupCallback)(void* arg);
+
+typedef struct {
+    TaskFunction function;
+    void* arg;
+    GroupCallback on_complete;
+    void* callback_arg;
+    atomic_int remaining;
+} TaskGroup;
+
+typedef struct {
+    TaskGroup* group;
+    int begin;
+    int end;
+} Task;
+
+typedef struct Scheduler Scheduler;
+
+typedef struct {
+    Scheduler* scheduler;
+    int id;
+    int cpu;                    // CPU the worker is pinned to, -1 if placement is left to the OS
+
+    // Deque of tasks, thieves steal from the top (oldest). The owner continues the group it ran last from the
+    // bottom and otherwise also takes the oldest task, so independent groups are served in submission order
+    Task* tasks;
+    int capacity;
+    int top;
+    int count;
+    pthread_mutex_t lock;
+    pthread_t thread;
+    TaskGroup* current_group;   // Group of the task run last, only compared, never dereferenced
+
+    // Statistics, only written by the owning worker but read by any thread
+    _Atomic double busy_time;
+    atomic_long tasks_run;
+    atomic_long tasks_stolen;
+} Worker;
+
+struct Scheduler {
+    int num_workers;
+    Worker* workers;
+    int num_started;
+    atomic_int pending_tasks;
+    atomic_uint next_worker;
+    int running;                // Set once the worker set is final, workers wait for it before taking tasks
+    int shutdown;
+    double start_time;
+    pthread_mutex_t idle_lock;
+    pthread_cond_t work_available;
+};
+
+/**
+ * @brief Returns the current wall clock time in seconds, used for task and simulation timings.
+ */
+double wall_time(void);
+
+/**
+ * @brief Creates a work-stealing scheduler and starts its worker threads.
+ *
+ * Every worker owns a deque of tasks. Workers keep working on the chunks of their current group from the bottom of
+ * their own deque, start the oldest group otherwise and steal from the top of other workers' deques when theirs is
+ * empty, so uneven chunks do not leave cores idle at the tail and earlier submissions finish first.
+ *
+ * @param num_workers Number of worker threads, `0` uses one per CPU the process is allowed to run on.
+ * @param pin_threads `1` pins worker `i` to the `i`-th allowed CPU (modulo the number of allowed CPUs), `0` leaves
+ *                    placement to the OS.
+ * @return Pointer to the dynamically allocated `Scheduler`, or NULL on failure. Must be freed using `destroy_scheduler`.
+ */
+Scheduler* create_scheduler(int num_workers, int pin_threads);
+
+/**
+ * @brief Waits for all queued tasks, stops the worker threads and frees the scheduler.
+ *
+ * @param scheduler Pointer to the `Scheduler`. If NULL, the function does nothing.
+ */
+void destroy_scheduler(Scheduler* scheduler);
+
+/**
+ * @brief Splits `[0, count)` into chunks of `chunk_size` items and distributes them over the worker deques.
+ *
+ * The group's function is called once per chunk on some worker, afterwards the worker that finished the
+ * last chunk calls `on_complete` (if set). The group must stay valid until `on_complete` was called.
+ * Safe to call from any thread, including from within a running task.
+ *
+ * @param scheduler Pointer to the `Scheduler`.
+ * @param group Pointer to an initialized task group, its `remaining` counter is set by this function.
+ * @param count Number of items, must be greater than 0.
+ * @param chunk_size Number of items per chunk, must be greater than 0.
+ * @return int Returns `0` on success, `1` if the tasks could not be queued, in which case none of them was queued
+ *             and the group can be released right away.
+ */
+int scheduler_submit(Scheduler* scheduler, TaskGroup* group, int count, int chunk_size);
+
+/**
+ * @brief Prints tasks run, tasks stolen, busy time and utilization of every worker.
+ *
+ * Utilization is the share of time since the scheduler was created that a worker spent executing tasks.
+ *
+ * @param scheduler Pointer to the `Scheduler`.
+ * @param out Stream to print to.
+ */
+void print_scheduler_stats(Scheduler* scheduler, FILE* out);
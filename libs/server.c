@@ -0,0 +1,651 @@
+#define _POSIX_C_SOURCE 200809L
+#include "server.h"
+#include "game_board.h"
+#include "sim.h"
+#include "arena.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <unistd.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#define SERVER_MAX_OVERRIDES 16
+
+typedef struct {
+    FILE* out;
+    int broken;                 // Set once a write failed, e.g. because the client disconnected
+    int pending;
+    pthread_mutex_t lock;
+    pthread_cond_t done;
+} Connection;
+
+typedef struct {
+    int used;
+    int refs;
+    unsigned long long hash;
+    unsigned long last_used;
+    Config key;
+    GameBoard* board;
+    Arena arena;
+} CacheEntry;
+
+typedef struct Server Server;
+
+typedef struct Job {
+    struct Job* next_free;
+    Server* server;
+    Connection* conn;
+    Arena arena;                // Owns the request, config, private board and results, reset when the job is recycled
+    char* request;
+    TaskGroup prepare;
+
+    // Filled by `prepare_job`
+    const char* id;
+    const char* error;
+    Config* config;
+    CacheEntry* entry;
+    GameBoard* board;
+    int cache_hit;
+} Job;
+
+typedef struct ConnectionThread {
+    struct ConnectionThread* next;
+    Server* server;
+    FILE* in;
+    FILE* out;
+    pthread_t thread;
+    atomic_int finished;
+} ConnectionThread;
+
+struct Server {
+    Scheduler* scheduler;
+    atomic_int shutdown_requested;
+    int wake_fd;                // Write end of a pipe that wakes up the accept loop, -1 when serving stdin
+
+    // Jobs that are not in flight, bounds the number of queued requests
+    Job jobs[SERVER_QUEUE_SIZE];
+    Job* free_jobs;
+    pthread_mutex_t jobs_lock;
+    pthread_cond_t job_available;
+
+    // Board cache
+    CacheEntry cache[SERVER_CACHE_SIZE];
+    unsigned long cache_clock;
+    pthread_mutex_t cache_lock;
+};
+
+/**
+ * @brief Hashes everything a game board depends on (FNV-1a over size, dice and transitions).
+ */
+static unsigned long long hash_board(Config* config) {
+    unsigned long long hash = 0xcbf29ce484222325ULL;
+    int fields[] = { config->rows, config->cols, config->dice_sides, config->num_snakes, config->num_ladders };
+    const unsigned char* bytes = (const unsigned char*) fields;
+    for (size_t i = 0; i < sizeof(fields); i++) hash = (hash ^ bytes[i]) * 0x100000001b3ULL;
+
+    for (int i = 0; i < config->num_snakes; i++) {
+        hash = (hash ^ (unsigned) config->snakes[i].start) * 0x100000001b3ULL;
+        hash = (hash ^ (unsigned) config->snakes[i].end) * 0x100000001b3ULL;
+    }
+    for (int i = 0; i < config->num_ladders; i++) {
+        hash = (hash ^ (unsigned) config->ladders[i].start) * 0x100000001b3ULL;
+        hash = (hash ^ (unsigned) config->ladders[i].end) * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+/**
+ * @brief Compares everything a game board depends on, used to rule out hash collisions.
+ */
+static int same_board(Config* a, Config* b) {
+    if (a->rows != b->rows || a->cols != b->cols || a->dice_sides != b->dice_sides ||
+        a->num_snakes != b->num_snakes || a->num_ladders != b->num_ladders) {
+        return 0;
+    }
+    for (int i = 0; i < a->num_snakes; i++) {
+        if (a->snakes[i].start != b->snakes[i].start || a->snakes[i].end != b->snakes[i].end) return 0;
+    }
+    for (int i = 0; i < a->num_ladders; i++) {
+        if (a->ladders[i].start != b->ladders[i].start || a->ladders[i].end != b->ladders[i].end) return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Looks up the board for a configuration and builds it on a miss.
+ *
+ * On a miss the least recently used entry that is not referenced by a running job is replaced, its arena is
+ * reset and reused for the new board. Returns NULL if every entry is in use or the board cannot be built.
+ */
+static CacheEntry* cache_acquire(Server* server, Config* config, int* hit) {
+    unsigned long long hash = hash_board(config);
+    CacheEntry* victim = NULL;
+    *hit = 0;
+
+    pthread_mutex_lock(&server->cache_lock);
+    for (int i = 0; i < SERVER_CACHE_SIZE; i++) {
+        CacheEntry* entry = &server->cache[i];
+        if (entry->used && entry->hash == hash && same_board(&entry->key, config)) {
+            entry->refs++;
+            entry->last_used = ++server->cache_clock;
+            *hit = 1;
+            pthread_mutex_unlock(&server->cache_lock);
+            return entry;
+        }
+        if (entry->refs == 0 && (!victim || !entry->used || (victim->used && entry->last_used < victim->last_used))) {
+            victim = entry;
+        }
+    }
+
+    if (victim) {
+        arena_reset(&victim->arena);
+        victim->board = create_game_board(config, &victim->arena);
+        victim->used = victim->board != NULL;
+        if (victim->used) {
+            victim->hash = hash;
+            victim->key = *config;
+            victim->refs = 1;
+            victim->last_used = ++server->cache_clock;
+        } else {
+            victim = NULL;
+        }
+    }
+    pthread_mutex_unlock(&server->cache_lock);
+    return victim;
+}
+
+static void cache_release(Server* server, CacheEntry* entry) {
+    pthread_mutex_lock(&server->cache_lock);
+    entry->refs--;
+    pthread_mutex_unlock(&server->cache_lock);
+}
+
+/**
+ * @brief Writes a JSON string literal, escaping quotes, backslashes and control characters.
+ */
+static void write_json_string(FILE* out, const char* text) {
+    fputc('"', out);
+    for (const char* c = text; *c; c++) {
+        if (*c == '"' || *c == '\\') {
+            fputc('\\', out);
+            fputc(*c, out);
+        } else if ((unsigned char) *c < 0x20) {
+            fprintf(out, "\\u%04x", (unsigned char) *c);
+        } else {
+            fputc(*c, out);
+        }
+    }
+    fputc('"', out);
+}
+
+/**
+ * @brief Flushes a response, a failed write marks the connection as broken so later responses are dropped.
+ *
+ * Must be called with the connection's lock held.
+ */
+static void finish_response(Connection* conn) {
+    if (fflush(conn->out) != 0 || ferror(conn->out)) {
+        conn->broken = 1;
+        LOG_INFO("Client disconnected, dropping its remaining responses.");
+    }
+}
+
+static void respond_error(Connection* conn, const char* id, const char* message) {
+    pthread_mutex_lock(&conn->lock);
+    if (conn->broken) {
+        pthread_mutex_unlock(&conn->lock);
+        return;
+    }
+    fputs("{\"id\":", conn->out);
+    write_json_string(conn->out, id);
+    fputs(",\"status\":\"error\",\"message\":", conn->out);
+    write_json_string(conn->out, message);
+    fputs("}\n", conn->out);
+    finish_response(conn);
+    pthread_mutex_unlock(&conn->lock);
+}
+
+static void respond_results(Connection* conn, const char* id, Config* config, SimResults* results, int cache_hit) {
+    pthread_mutex_lock(&conn->lock);
+    if (conn->broken) {
+        pthread_mutex_unlock(&conn->lock);
+        return;
+    }
+    fputs("{\"id\":", conn->out);
+    write_json_string(conn->out, id);
+    fprintf(conn->out,
+        ",\"status\":\"ok\",\"board_cache\":\"%s\",\"iterations\":%d,\"games_won\":%d,\"aborted\":%d,"
+        "\"avg_rolls\":%.4f,\"overshots\":%d,\"shortest\":%d,\"elapsed_time\":%.6f}\n",
+        cache_hit ? "hit" : "miss", config->iterations, config->iterations - results->aborted_iterations,
+        results->aborted_iterations, results->avg_rolls, results->overshots, results->shortest_num_of_rolls,
+        results->elapsed_time);
+    finish_response(conn);
+    pthread_mutex_unlock(&conn->lock);
+}
+
+/**
+ * @brief Reads a whole configuration file into the arena, leaving room for `extra` more bytes.
+ */
+static char* read_file(const char* path, size_t extra, size_t* length, Arena* arena) {
+    FILE* file = fopen(path, "rb");
+    if (!file) return NULL;
+
+    char* text = NULL;
+    if (fseek(file, 0, SEEK_END) == 0) {
+        long size = ftell(file);
+        rewind(file);
+        if (size >= 0 && (text = arena_alloc(arena, size + extra + 1))) {
+            *length = fread(text, 1, size, file);
+            text[*length] = '\0';
+        }
+    }
+    fclose(file);
+    return text;
+}
+
+/**
+ * @brief Returns a job to the free list once its response has been written.
+ */
+static void finish_job(Job* job) {
+    Server* server = job->server;
+    Connection* conn = job->conn;
+
+    pthread_mutex_lock(&server->jobs_lock);
+    job->next_free = server->free_jobs;
+    server->free_jobs = job;
+    pthread_cond_signal(&server->job_available);
+    pthread_mutex_unlock(&server->jobs_lock);
+
+    pthread_mutex_lock(&conn->lock);
+    if (--conn->pending == 0) pthread_cond_broadcast(&conn->done);
+    pthread_mutex_unlock(&conn->lock);
+}
+
+/**
+ * @brief Task function, parses a request and looks up its board. Errors are stored in the job.
+ */
+static void prepare_job(void* arg, int begin, int end, int worker) {
+    (void) begin;
+    (void) end;
+    (void) worker;
+    static const char* OVERRIDE_KEYS[] = { "ITERATIONS=", "MAXSIMSTEPS=", "DICE=", "ALLOW_OVERSHOOT=", "SEED=" };
+    Job* job = arg;
+    const char* config_path = NULL;
+    char* inline_config = NULL;
+    size_t overrides_length = 0;
+
+    // First pass: find id and config source, validate overrides
+    char* save = NULL;
+    char* tokens[SERVER_MAX_OVERRIDES];
+    int num_tokens = 0;
+    for (char* token = strtok_r(job->request, " \t\r\n", &save); token; token = strtok_r(NULL, " \t\r\n", &save)) {
+        if (strncmp(token, "id=", 3) == 0) {
+            job->id = token + 3;
+        } else if (strncmp(token, "config=", 7) == 0 || strncmp(token, "inline=", 7) == 0) {
+            if (config_path || inline_config) {
+                job->error = "Exactly one of config= or inline= is required.";
+                return;
+            }
+            if (token[0] == 'c') config_path = token + 7; else inline_config = token + 7;
+        } else {
+            int known = 0;
+            for (size_t k = 0; k < sizeof(OVERRIDE_KEYS) / sizeof(OVERRIDE_KEYS[0]); k++) {
+                if (strncmp(token, OVERRIDE_KEYS[k], strlen(OVERRIDE_KEYS[k])) == 0) known = 1;
+            }
+            if (!known) {
+                job->error = "Unknown request key, overrides are limited to ITERATIONS, MAXSIMSTEPS, DICE, ALLOW_OVERSHOOT and SEED.";
+                return;
+            }
+            if (num_tokens == SERVER_MAX_OVERRIDES) {
+                job->error = "Too many overrides.";
+                return;
+            }
+            tokens[num_tokens++] = token;
+            overrides_length += strlen(token) + 1;
+        }
+    }
+
+    if (!config_path == !inline_config) {
+        job->error = "Exactly one of config= or inline= is required.";
+        return;
+    }
+
+    // Build the configuration text, overrides are appended so they win over the file's values
+    size_t length = 0;
+    char* text;
+    if (config_path) {
+        text = read_file(config_path, overrides_length + 1, &length, &job->arena);
+        if (!text) {
+            job->error = "Could not read config file.";
+            return;
+        }
+    } else {
+        length = strlen(inline_config);
+        text = arena_alloc(&job->arena, length + overrides_length + 2);
+        if (!text) {
+            job->error = "Memory allocation failed for inline config.";
+            return;
+        }
+        for (size_t i = 0; i < length; i++) text[i] = inline_config[i] == ';' ? '\n' : inline_config[i];
+    }
+    text[length++] = '\n';
+    for (int i = 0; i < num_tokens; i++) {
+        size_t token_length = strlen(tokens[i]);
+        memcpy(text + length, tokens[i], token_length);
+        length += token_length;
+        text[length++] = '\n';
+    }
+
+    Config* config = arena_alloc(&job->arena, sizeof(Config));
+    FILE* stream = fmemopen(text, length, "r");
+    int parse_failed = !config || !stream || parse_config_stream(stream, config);
+    if (stream) fclose(stream);
+    if (parse_failed) {
+        job->error = "Invalid configuration.";
+        return;
+    }
+    job->config = config;
+
+    job->entry = cache_acquire(job->server, config, &job->cache_hit);
+    // Every cache entry is in use by another job, build a private board instead
+    job->board = job->entry ? job->entry->board : create_game_board(config, &job->arena);
+    if (!job->board) job->error = "Simulation failed.";
+}
+
+/**
+ * @brief Simulation callback, writes the response and recycles the job.
+ */
+static void sim_done(SimResults* results, void* arg) {
+    Job* job = arg;
+    respond_results(job->conn, job->id, job->config, results, job->cache_hit);
+    if (job->entry) cache_release(job->server, job->entry);
+    finish_job(job);
+}
+
+/**
+ * @brief Completion callback of the prepare task, starts the simulation on the same scheduler.
+ *
+ * The job must not be touched once the simulation was started, its callback may already have recycled it.
+ */
+static void after_prepare(void* arg) {
+    Job* job = arg;
+    if (!job->error &&
+        start_sim(job->board, job->config, &job->arena, job->server->scheduler, sim_done, job)) {
+        return;
+    }
+
+    respond_error(job->conn, job->id, job->error ? job->error : "Simulation failed.");
+    if (job->entry) cache_release(job->server, job->entry);
+    finish_job(job);
+}
+
+/**
+ * @brief Copies a request into a free job and queues it, blocks while every job is in flight.
+ */
+static void submit_job(Server* server, Connection* conn, const char* request) {
+    pthread_mutex_lock(&server->jobs_lock);
+    while (!server->free_jobs) {
+        pthread_cond_wait(&server->job_available, &server->jobs_lock);
+    }
+    Job* job = server->free_jobs;
+    server->free_jobs = job->next_free;
+    pthread_mutex_unlock(&server->jobs_lock);
+
+    arena_reset(&job->arena);
+    job->conn = conn;
+    job->id = "";
+    job->error = NULL;
+    job->config = NULL;
+    job->entry = NULL;
+    job->board = NULL;
+    job->cache_hit = 0;
+
+    pthread_mutex_lock(&conn->lock);
+    conn->pending++;
+    pthread_mutex_unlock(&conn->lock);
+
+    size_t length = strlen(request);
+    job->request = arena_alloc(&job->arena, length + 1);
+    if (!job->request) {
+        respond_error(conn, "", "Memory allocation failed for request.");
+        finish_job(job);
+        return;
+    }
+    memcpy(job->request, request, length + 1);
+
+    job->prepare = (TaskGroup) { .function = prepare_job, .arg = job, .on_complete = after_prepare, .callback_arg = job };
+    if (scheduler_submit(server->scheduler, &job->prepare, 1, 1) != 0) {
+        respond_error(conn, "", "Could not queue request.");
+        finish_job(job);
+    }
+}
+
+/**
+ * @brief Reads requests from one input stream until it ends and waits for all of its jobs.
+ *
+ * @return 1 if a shutdown was requested; 0 otherwise.
+ */
+static int serve_connection(Server* server, FILE* in, FILE* out) {
+    Connection conn = { .out = out, .broken = 0, .pending = 0 };
+    pthread_mutex_init(&conn.lock, NULL);
+    pthread_cond_init(&conn.done, NULL);
+
+    char line[SERVER_MAX_REQUEST_LENGTH];
+    int shutdown_requested = 0;
+    while (!shutdown_requested && fgets(line, SERVER_MAX_REQUEST_LENGTH, in)) {
+        if (!strchr(line, '\n') && strlen(line) == SERVER_MAX_REQUEST_LENGTH - 1) {
+            // Never run a truncated request, skip the rest of the line and answer it once
+            int c;
+            while ((c = fgetc(in)) != EOF && c != '\n') {}
+            respond_error(&conn, "", "Request too long.");
+            continue;
+        }
+        line[strcspn(line, "\r\n")] = '\0';
+        char* request = line + strspn(line, " \t");
+        if (*request == '\0' || *request == '#') continue;
+        if (strcmp(request, "shutdown") == 0) {
+            shutdown_requested = 1;
+            continue;
+        }
+
+        submit_job(server, &conn, request);
+    }
+
+    pthread_mutex_lock(&conn.lock);
+    while (conn.pending > 0) pthread_cond_wait(&conn.done, &conn.lock);
+    pthread_mutex_unlock(&conn.lock);
+
+    pthread_cond_destroy(&conn.done);
+    pthread_mutex_destroy(&conn.lock);
+    return shutdown_requested;
+}
+
+static void request_shutdown(Server* server) {
+    atomic_store(&server->shutdown_requested, 1);
+    if (server->wake_fd >= 0) {
+        ssize_t written = write(server->wake_fd, "x", 1);
+        (void) written;
+    }
+}
+
+static void* connection_thread(void* arg) {
+    ConnectionThread* connection = arg;
+    if (serve_connection(connection->server, connection->in, connection->out)) {
+        request_shutdown(connection->server);
+    }
+    fclose(connection->in);
+    fclose(connection->out);
+    atomic_store(&connection->finished, 1);
+    return NULL;
+}
+
+/**
+ * @brief Accepts one connection and serves it on its own thread.
+ *
+ * @return 1 if a connection was taken from the backlog; 0 if accepting failed (e.g. the backlog is empty).
+ */
+static int accept_connection(Server* server, int listen_fd, ConnectionThread** connections) {
+    int fd = accept(listen_fd, NULL, NULL);
+    if (fd < 0) return 0;
+
+    int out_fd = dup(fd);
+    FILE* in = fdopen(fd, "r");
+    FILE* out = out_fd >= 0 ? fdopen(out_fd, "w") : NULL;
+    ConnectionThread* connection = in && out ? calloc(1, sizeof(ConnectionThread)) : NULL;
+    if (!connection) {
+        LOG_ERROR("Could not open streams for connection.");
+        if (in) fclose(in); else close(fd);
+        if (out) fclose(out); else if (out_fd >= 0) close(out_fd);
+        return 1;
+    }
+
+    connection->server = server;
+    connection->in = in;
+    connection->out = out;
+    atomic_init(&connection->finished, 0);
+    if (pthread_create(&connection->thread, NULL, connection_thread, connection) != 0) {
+        LOG_ERROR("Could not start a thread for connection.");
+        fclose(in);
+        fclose(out);
+        free(connection);
+        return 1;
+    }
+    connection->next = *connections;
+    *connections = connection;
+    LOG_DEBUG("Accepted connection.");
+    return 1;
+}
+
+/**
+ * @brief Joins connection threads, only the finished ones unless `all` is set.
+ */
+static void join_connections(ConnectionThread** connections, int all) {
+    while (*connections) {
+        ConnectionThread* connection = *connections;
+        if (!all && !atomic_load(&connection->finished)) {
+            connections = &connection->next;
+            continue;
+        }
+        pthread_join(connection->thread, NULL);
+        *connections = connection->next;
+        free(connection);
+    }
+}
+
+/**
+ * @brief Accepts connections on a Unix domain socket and serves each of them on its own thread.
+ *
+ * Once a client requests a shutdown, no new connections are accepted, but connections already waiting in the
+ * listen backlog are still served. Returns after every open connection has been closed by its client.
+ */
+static int serve_socket(Server* server, const char* socket_path) {
+    struct sockaddr_un address = { .sun_family = AF_UNIX };
+    if (strlen(socket_path) >= sizeof(address.sun_path)) {
+        LOG_ERROR("Socket path '%s' is too long.", socket_path);
+        return 1;
+    }
+    strcpy(address.sun_path, socket_path);
+
+    int wake_fds[2];
+    if (pipe(wake_fds) != 0) {
+        LOG_ERROR("Could not create wake up pipe.");
+        return 1;
+    }
+    int listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_fd < 0) {
+        LOG_ERROR("Could not create socket.");
+        close(wake_fds[0]);
+        close(wake_fds[1]);
+        return 1;
+    }
+    unlink(socket_path);
+    if (bind(listen_fd, (struct sockaddr*) &address, sizeof(address)) != 0 || listen(listen_fd, SOMAXCONN) != 0) {
+        LOG_ERROR("Could not listen on socket '%s'.", socket_path);
+        close(listen_fd);
+        close(wake_fds[0]);
+        close(wake_fds[1]);
+        return 1;
+    }
+    server->wake_fd = wake_fds[1];
+    LOG_INFO("Listening on '%s'.", socket_path);
+
+    ConnectionThread* connections = NULL;
+    while (!atomic_load(&server->shutdown_requested)) {
+        struct pollfd fds[2] = { { .fd = listen_fd, .events = POLLIN }, { .fd = wake_fds[0], .events = POLLIN } };
+        if (poll(fds, 2, -1) > 0 && (fds[0].revents & POLLIN)) {
+            accept_connection(server, listen_fd, &connections);
+        }
+        join_connections(&connections, 0);
+    }
+
+    // Drain the backlog, clients that connected before the shutdown still get their answers
+    LOG_INFO("Shutdown requested, serving remaining connections.");
+    fcntl(listen_fd, F_SETFL, fcntl(listen_fd, F_GETFL) | O_NONBLOCK);
+    while (accept_connection(server, listen_fd, &connections)) {}
+    join_connections(&connections, 1);
+
+    server->wake_fd = -1;
+    close(listen_fd);
+    close(wake_fds[0]);
+    close(wake_fds[1]);
+    unlink(socket_path);
+    return 0;
+}
+
+int run_server(const char* socket_path, Scheduler* scheduler) {
+    if (!scheduler) {
+        LOG_ERROR("Invalid scheduler (NULL pointer).");
+        return 1;
+    }
+
+    Server* server = calloc(1, sizeof(Server));
+    if (!server) {
+        LOG_ERROR("Memory allocation failed for server.");
+        return 1;
+    }
+    server->scheduler = scheduler;
+    server->wake_fd = -1;
+    atomic_init(&server->shutdown_requested, 0);
+    // A client closing its connection early must not kill the server, failed writes are handled per connection
+    signal(SIGPIPE, SIG_IGN);
+    // The log level is shared by all jobs, a job's LOG_LEVEL= must not change it for the others
+    lock_log_level();
+    pthread_mutex_init(&server->jobs_lock, NULL);
+    pthread_cond_init(&server->job_available, NULL);
+    pthread_mutex_init(&server->cache_lock, NULL);
+    for (int i = 0; i < SERVER_QUEUE_SIZE; i++) {
+        server->jobs[i].server = server;
+        server->jobs[i].next_free = server->free_jobs;
+        server->free_jobs = &server->jobs[i];
+        arena_init(&server->jobs[i].arena, 0);
+    }
+    for (int i = 0; i < SERVER_CACHE_SIZE; i++) {
+        arena_init(&server->cache[i].arena, 0);
+    }
+
+    // Every connection waits for its own jobs, so nothing is in flight once serving returns
+    int return_val = 0;
+    if (socket_path) {
+        return_val = serve_socket(server, socket_path);
+    } else {
+        serve_connection(server, stdin, stdout);
+    }
+
+    for (int i = 0; i < SERVER_QUEUE_SIZE; i++) {
+        arena_free(&server->jobs[i].arena);
+    }
+    for (int i = 0; i < SERVER_CACHE_SIZE; i++) {
+        arena_free(&server->cache[i].arena);
+    }
+    pthread_mutex_destroy(&server->cache_lock);
+    pthread_cond_destroy(&server->job_available);
+    pthread_mutex_destroy(&server->jobs_lock);
+    free(server);
+    return return_val;
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include "config_manager.h"
+#include "scheduler.h"
+
+// Number of compiled boards kept in the least recently used cache
+#define SERVER_CACHE_SIZE 16
+// Maximum length of a single job request line in bytes, longer lines are answered with an error
+#define SERVER_MAX_REQUEST_LENGTH 16384
+// Number of requests that can be in flight before reading blocks
+#define SERVER_QUEUE_SIZE 64
+
+/**
+ * @brief Runs a long-running worker that accepts simulation jobs as line-delimited requests.
+ *
+ * Every request line is a whitespace separated list of `KEY=VALUE` tokens:
+ * - `id=ID` optional job identifier that is echoed in the response
+ * - `config=PATH` path to a configuration file, or
+ * - `inline=CONFIG` configuration given inline with `;` separating its lines (e.g. `ROWS=5;COLS=5;LADDERS=1;3:20`)
+ * - `ITERATIONS=`, `MAXSIMSTEPS=`, `DICE=`, `ALLOW_OVERSHOOT=`, `SEED=` override the configuration
+ * A line containing only `shutdown` stops the server once all pending jobs are done. On a socket, every
+ * connection is served on its own thread; after a shutdown request connections still waiting in the listen
+ * backlog are served and the server exits once every client has closed its connection.
+ *
+ * Jobs are parsed and simulated as tasks on the scheduler, so the games of concurrent jobs share its workers
+ * and an idle worker steals from a busy one. Each job is answered with a single line JSON object containing
+ * the `id`, a `status` of `ok` or `error` and the simulation statistics. Compiled boards are kept in a least
+ * recently used cache of `SERVER_CACHE_SIZE` entries, keyed by a hash of board size, dice and transitions,
+ * so repeated jobs for the same board skip board construction. Responses are written in completion order.
+ *
+ * @param socket_path Path of a Unix domain socket to listen on, or NULL to read requests from stdin and
+ *                    write responses to stdout.
+ * @param scheduler Pointer to the scheduler that runs the jobs.
+ * @return int Returns `0` after a clean shutdown or end of input, `1` on failure (e.g. socket setup).
+ */
+int run_server(const char* socket_path, Scheduler* scheduler);
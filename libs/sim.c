@@ -3,154 +3,317 @@
 #include <time.h>
 #include <stdio.h>
 #include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
 
 /**
  * @brief Rolls a die and returns a random value between 1 and the number of sides.
  *
- * This function generates a pseudo-random integer between 1 and `dice_sides`, simulating
- * the roll of a die with the specified number of sides.
+ * This function generates a pseudo-random integer between 1 and `dice_sides` using a xorshift64* generator,
+ * simulating the roll of a die with the specified number of sides.
  *
+ * @param state Pointer to the generator state of the calling simulation. Must not be zero.
  * @param dice_sides The number of sides on the die. Must be greater than 0.
  * @return A pseudo-random number in the range [1, dice_sides].
  *
- * @note This implementation uses `rand()` and is not thread-safe.
+ * @note Each chunk owns its state, so chunks can run concurrently.
  */
-int roll_dice(int dice_sides) {
-    return rand() % dice_sides + 1;
+static int roll_dice(unsigned long long* state, int dice_sides) {
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return (int) (((*state * 0x2545F4914F6CDD1DULL) >> 32) % dice_sides) + 1;
 }
 
-SimResults* run_sim(GameBoard* board, Config* config) {
-    if (!board || !board->start || !config) {
-        logm(ERROR, "run_sim", "Invalid board, start point or config (NULL pointer).");
+/**
+ * @brief Derives the seed of a simulation run.
+ *
+ * Uses the configured seed if there is one, otherwise the current time mixed with a process wide counter
+ * so that simulations started within the same second still get different roll sequences.
+ */
+static unsigned long long initial_seed(Config* config) {
+    static atomic_ullong run_counter = 0;
+    return config->seed ? config->seed : (unsigned long long) time(NULL) + atomic_fetch_add(&run_counter, 1);
+}
+
+/**
+ * @brief Derives the generator state of one chunk from the run's seed.
+ *
+ * Every chunk gets its own stream, so results only depend on the seed and not on which worker ran the chunk.
+ */
+static unsigned long long chunk_rng_state(unsigned long long seed, int chunk) {
+    // splitmix64 finalizer, guarantees a well mixed and non-zero state
+    unsigned long long x = seed + (unsigned long long) chunk * 0x9E3779B97F4A7C15ULL;
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    x ^= x >> 31;
+    return x ? x : 1;
+}
+
+/**
+ * @brief Returns the usage counter of the snake or ladder starting on `square` (binary search, few entries).
+ */
+static int transition_id(SimRun* run, int square) {
+    int low = 0, high = run->num_transitions - 1;
+    while (low < high) {
+        int middle = (low + high) / 2;
+        if (run->transition_starts[middle] < square) low = middle + 1; else high = middle;
+    }
+    return run->transition_ids[low];
+}
+
+/**
+ * @brief Plays a single game on the board.
+ *
+ * @param run The simulation run the game belongs to.
+ * @param rng_state Generator state of the current chunk.
+ * @param uses Usage counter per snake and ladder (snakes first, then ladders).
+ * @param rolls Incremented by the number of rolls that moved the player, only if the game was won.
+ * @param overshots Incremented if the game was won by overshooting the last square.
+ * @param sequence If not NULL, receives every roll of the game including rolls that did not move the player.
+ * @return The number of rolls needed to win, or `0` if the game was aborted.
+ */
+static int play_game(SimRun* run, unsigned long long* rng_state, int* uses, long long* rolls, int* overshots, int* sequence) {
+    GameBoard* board = run->board;
+    Config* config = run->config;
+    const int num_fields = board->rows * board->cols;
+    int sim_steps = 0;
+    int current_idx = -1;
+    int rolls_in_iter = 0;
+    Node* current = NULL;
+
+    while (1) {
+        if (++sim_steps >= config->max_simulation_steps) {
+            return 0;
+        }
+
+        int roll = roll_dice(rng_state, config->dice_sides);
+        int target_idx = current_idx + roll;
+        if (sequence) sequence[sim_steps - 1] = roll;
+
+        // Overshoot handling
+        if (target_idx >= num_fields) {
+            if (config->allow_overshoot) {
+                (*overshots)++;
+                target_idx = current_idx + num_fields - 1 - current_idx;
+            } else {
+                // Retry this roll
+                continue;
+            }
+        }
+
+        rolls_in_iter++;
+        
+        if (!current) {
+            // Current hasn't been filled yet
+            current = &board->start[target_idx];
+        } else {
+            // If the game was won by overshot, the roll needs to be adjusted otherwise it will cause idx out of bounds issues
+            // otherwise just use the rolled value - 1
+            current = (target_idx == num_fields - 1 && config->allow_overshoot) ? 
+                current->successors[num_fields - 1 - current_idx - 1] : 
+                current->successors[roll - 1];
+        }
+
+        current_idx = target_idx;
+
+        // Handle Snake or Ladder
+        if (current->ft != DEFAULT) {
+            uses[transition_id(run, current_idx)]++;
+            current_idx = board->jumps[current_idx];
+            current = &board->start[current_idx];
+        }
+
+        if (current_idx == num_fields - 1) {
+            // Reached end of board
+            // Only count rolls the lead to winning the game | ignore all rolls that lead to abortion of game
+            *rolls += rolls_in_iter;
+            return sim_steps;
+        }
+    }
+}
+
+/**
+ * @brief Task function, plays the games `[begin, end)` of a run.
+ *
+ * Statistics are accumulated in chunk-local buffers on the worker's own stack and merged into the run's
+ * results once per chunk, so workers never write to shared memory inside the game loop.
+ */
+static void simulate_chunk(void* arg, int begin, int end, int worker) {
+    (void) worker;
+    SimRun* run = arg;
+    const int num_transitions = run->config->num_snakes + run->config->num_ladders;
+    double start_time = wall_time();
+    unsigned long long rng_state = chunk_rng_state(run->seed, begin / SIM_CHUNK_ITERATIONS);
+
+    int uses[MAX_SNAKES + MAX_LADDERS] = { 0 };
+    long long total_rolls = 0;
+    int overshots = 0;
+    int aborted_iterations = 0;
+    int shortest = -1;
+    int shortest_iteration = -1;
+
+    for (int i = begin; i < end; i++) {
+        int sim_steps = play_game(run, &rng_state, uses, &total_rolls, &overshots, NULL);
+        if (sim_steps == 0) {
+            aborted_iterations++;
+        } else if (shortest == -1 || sim_steps < shortest) {
+            shortest = sim_steps;
+            shortest_iteration = i;
+        }
+    }
+
+    pthread_mutex_lock(&run->lock);
+    SimResults* results = run->results;
+    if (run->start_time == 0 || start_time < run->start_time) run->start_time = start_time;
+    run->total_rolls += total_rolls;
+    results->overshots += overshots;
+    results->aborted_iterations += aborted_iterations;
+    for (int k = 0; k < num_transitions; k++) {
+        if (k < run->config->num_snakes) {
+            results->snakes[k].times_used += uses[k];
+        } else {
+            results->ladders[k - run->config->num_snakes].times_used += uses[k];
+        }
+    }
+    // Ties are broken by iteration so the shortest game does not depend on scheduling
+    if (shortest != -1 && (results->shortest_num_of_rolls == -1 || shortest < results->shortest_num_of_rolls ||
+        (shortest == results->shortest_num_of_rolls && shortest_iteration < run->shortest_iteration))) {
+        results->shortest_num_of_rolls = shortest;
+        run->shortest_iteration = shortest_iteration;
+    }
+    pthread_mutex_unlock(&run->lock);
+}
+
+/**
+ * @brief Completion callback, computes the final statistics once every chunk has been played.
+ *
+ * The roll sequence of the shortest game is not recorded while simulating. Instead the chunk containing it
+ * is replayed from its seed up to that game.
+ */
+static void finish_sim(void* arg) {
+    SimRun* run = arg;
+    SimResults* results = run->results;
+    Config* config = run->config;
+
+    int completed_iterations = config->iterations - results->aborted_iterations;
+    results->avg_rolls = (completed_iterations > 0) ? (double) run->total_rolls / completed_iterations : 0.0;
+
+    if (results->shortest_num_of_rolls != -1) {
+        int chunk = run->shortest_iteration / SIM_CHUNK_ITERATIONS;
+        unsigned long long rng_state = chunk_rng_state(run->seed, chunk);
+        int uses[MAX_SNAKES + MAX_LADDERS] = { 0 };
+        long long rolls = 0;
+        int overshots = 0;
+        for (int i = chunk * SIM_CHUNK_ITERATIONS; i <= run->shortest_iteration; i++) {
+            play_game(run, &rng_state, uses, &rolls, &overshots,
+                i == run->shortest_iteration ? results->shortest_roll_sequence : NULL);
+        }
+    }
+    results->elapsed_time = wall_time() - run->start_time;
+
+    if (run->on_complete) {
+        // The callback may release the memory of the run
+        pthread_mutex_destroy(&run->lock);
+        pthread_cond_destroy(&run->finished);
+        run->on_complete(results, run->callback_arg);
+        return;
+    }
+
+    pthread_mutex_lock(&run->lock);
+    run->done = 1;
+    pthread_cond_signal(&run->finished);
+    pthread_mutex_unlock(&run->lock);
+}
+
+SimRun* start_sim(GameBoard* board, Config* config, Arena* arena, Scheduler* scheduler, SimCallback on_complete, void* callback_arg) {
+    if (!board || !board->start || !config || !arena || !scheduler) {
+        LOG_ERROR("Invalid board, start point, config, arena or scheduler (NULL pointer).");
         return NULL;
     }
 
-    srand(time(NULL));
+    // Every buffer is allocated up front, the simulation itself does not allocate
+    SimRun* run = arena_alloc(arena, sizeof(SimRun));
+    SimResults* results = arena_alloc(arena, sizeof(SimResults));
+    int* shortest_roll_sequence = arena_calloc(arena, config->max_simulation_steps, sizeof(int));
+    if (!run || !results || !shortest_roll_sequence) {
+        LOG_ERROR("Memory allocation failed for simulation run.");
+        return NULL;
+    }
 
-    const int num_fields = board->rows * board->cols;
-    int total_rolls = 0;
+    // Sort the start squares of all snakes and ladders (insertion sort, few entries) to look up usage counters
+    run->num_transitions = config->num_snakes + config->num_ladders;
+    for (int j = 0; j < run->num_transitions; j++) {
+        int start = (j < config->num_snakes ? config->snakes[j].start : config->ladders[j - config->num_snakes].start) - 1;
+        int k = j;
+        for (; k > 0 && run->transition_starts[k - 1] > start; k--) {
+            run->transition_starts[k] = run->transition_starts[k - 1];
+            run->transition_ids[k] = run->transition_ids[k - 1];
+        }
+        run->transition_starts[k] = start;
+        run->transition_ids[k] = j;
+    }
 
-    SimResults* results = malloc(sizeof(SimResults));
     results->avg_rolls = 0;
     results->overshots = 0;
     results->shortest_num_of_rolls = -1;
     results->aborted_iterations = 0;
-    results->elapsed_time = (double) clock() / CLOCKS_PER_SEC;
-    results->shortest_roll_sequence = NULL;
+    results->elapsed_time = 0;
+    results->shortest_roll_sequence = shortest_roll_sequence;
     
     memcpy(results->snakes, config->snakes, sizeof(Transition) * config->num_snakes);
     memcpy(results->ladders, config->ladders, sizeof(Transition) * config->num_ladders);
-    
-    int* roll_sequence = calloc(config->max_simulation_steps, sizeof(int));
-    if (!roll_sequence) {
-        logm(ERROR, "run_sim", "Memory allocation failed for roll_sequence.");
-        free(results);
-        return NULL;
-    }
-
-    for (int i = 0; i < config->iterations; i++) {
-        int sim_steps = 0;
-        int current_idx = -1;
-        int rolls_in_iter = 0;
-        Node* current = NULL;
+    for (int j = 0; j < config->num_snakes; j++) results->snakes[j].times_used = 0;
+    for (int j = 0; j < config->num_ladders; j++) results->ladders[j].times_used = 0;
 
-        while (1) {
-            if (++sim_steps >= config->max_simulation_steps) {
-                results->aborted_iterations++;
-                break;
-            }
-
-            int roll = roll_dice(config->dice_sides);
-            int target_idx = current_idx + roll;
-
-            // Overshoot handling
-            if (target_idx >= num_fields) {
-                if (config->allow_overshoot) {
-                    results->overshots++;
-                    target_idx = current_idx + num_fields - 1 - current_idx;
-                } else {
-                    // Retry this roll
-                    roll_sequence[sim_steps - 1] = roll;
-                    continue;
-                }
-            }
-
-            roll_sequence[sim_steps - 1] = roll;
-            rolls_in_iter++;
-            
-            if (!current) {
-                // Current hasn't been filled yet
-                current = board->start[target_idx];
-            } else {
-                // If the game was won by overshot, the roll needs to be adjusted otherwise it will cause idx out of bounds issues
-                // otherwise just use the rolled value - 1
-                current = (target_idx == num_fields - 1 && config->allow_overshoot) ? 
-                    current->successors[num_fields - 1 - current_idx - 1] : 
-                    current->successors[roll - 1];
-            }
+    run->board = board;
+    run->config = config;
+    run->results = results;
+    run->seed = initial_seed(config);
+    run->total_rolls = 0;
+    run->start_time = 0;
+    run->shortest_iteration = -1;
+    run->on_complete = on_complete;
+    run->callback_arg = callback_arg;
+    run->done = 0;
+    pthread_mutex_init(&run->lock, NULL);
+    pthread_cond_init(&run->finished, NULL);
 
-            current_idx = target_idx;
-
-            // Handle Snake
-            if (current->ft == SNAKE) {
-                for (int j = 0; j < config->num_snakes; j++) {
-                    if (results->snakes[j].start - 1 == current_idx) {
-                        results->snakes[j].times_used++;
-                        current_idx = results->snakes[j].end - 1;
-                        current = current->successors[0];
-                        break;
-                    }
-                }
-            } 
-            // Handle Ladder
-            else if (current->ft == LADDER) {
-                for (int j = 0; j < config->num_ladders; j++) {
-                    if (results->ladders[j].start - 1 == current_idx) {
-                        results->ladders[j].times_used++;
-                        current_idx = results->ladders[j].end - 1;
-                        current = current->successors[0];
-                        break;
-                    }
-                }
-            }
+    run->group.function = simulate_chunk;
+    run->group.arg = run;
+    run->group.on_complete = finish_sim;
+    run->group.callback_arg = run;
+    if (scheduler_submit(scheduler, &run->group, config->iterations, SIM_CHUNK_ITERATIONS) != 0) {
+        LOG_ERROR("Could not submit simulation to the scheduler.");
+        return NULL;
+    }
+    return run;
+}
 
-            if (current_idx == num_fields - 1) {
-                // Reached end of board
-                if (results->shortest_num_of_rolls == -1 || sim_steps < results->shortest_num_of_rolls) {
-                    results->shortest_num_of_rolls = sim_steps;
-                    int* seq_copy = calloc(config->max_simulation_steps, sizeof(int));
-                    if (!seq_copy) {
-                        logm(ERROR, "run_sim", "Memory allocation failed for seq_copy.");
-                        free(results);
-                        free(roll_sequence);
-                        return NULL;
-                    }
-                    memcpy(seq_copy, roll_sequence, sizeof(int) * sim_steps);
-                    if (results->shortest_roll_sequence != NULL) {
-                        free(results->shortest_roll_sequence);
-                    }
-                    results->shortest_roll_sequence = seq_copy;
-                }
-                // Only count rolls the lead to winning the game | ignore all rolls that lead to abortion of game
-                total_rolls += rolls_in_iter; 
-                // Reset roll sequence for next iteration
-                memset(roll_sequence, 0, sizeof(int) * config->max_simulation_steps);
-                break;
-            }
-        }
+SimResults* wait_sim(SimRun* run) {
+    if (!run || run->on_complete) {
+        LOG_ERROR("Invalid run (NULL pointer or completion callback set).");
+        return NULL;
     }
-    free(roll_sequence);
 
-    int completed_iterations = config->iterations - results->aborted_iterations;
-    results->avg_rolls = (completed_iterations > 0) ? (double) total_rolls / completed_iterations : 0.0;
-    results->elapsed_time = ((double) clock() / CLOCKS_PER_SEC) - results->elapsed_time;
+    pthread_mutex_lock(&run->lock);
+    while (!run->done) pthread_cond_wait(&run->finished, &run->lock);
+    pthread_mutex_unlock(&run->lock);
+
+    pthread_mutex_destroy(&run->lock);
+    pthread_cond_destroy(&run->finished);
+    return run->results;
+}
 
-    return results;
+SimResults* run_sim(GameBoard* board, Config* config, Arena* arena, Scheduler* scheduler) {
+    SimRun* run = start_sim(board, config, arena, scheduler, NULL, NULL);
+    return run ? wait_sim(run) : NULL;
 }
 
 void print_sim_results(SimResults* results, Config* config) {
     if (!results || !config) {
-        logm(ERROR, "run_sim", "Invalid result or config (NULL pointer).");
+        LOG_ERROR("Invalid result or config (NULL pointer).");
         return;
     }
 
@@ -1,6 +1,11 @@
 #pragma once
 #include "config_manager.h"
 #include "game_board.h"
+#include "scheduler.h"
+#include <pthread.h>
+
+// Number of games played per scheduler task
+#define SIM_CHUNK_ITERATIONS 256
 
 typedef struct {
     float avg_rolls;
@@ -10,23 +15,76 @@ typedef struct {
     Transition snakes[MAX_SNAKES];
     Transition ladders[MAX_SNAKES];
     int* shortest_roll_sequence;
-    double elapsed_time;
+    double elapsed_time;            // From the start of the first chunk to the end of the last, excludes queueing
 } SimResults;
 
+typedef void (*SimCallback)(SimResults* results, void* arg);
+
+/**
+ * @brief State of a simulation that is running on a scheduler.
+ */
+typedef struct {
+    GameBoard* board;
+    Config* config;
+    int num_transitions;
+    int transition_starts[MAX_SNAKES + MAX_LADDERS];    // 0-based start squares of all snakes and ladders, ascending
+    int transition_ids[MAX_SNAKES + MAX_LADDERS];       // Usage counter of the transition at the same position (snakes first)
+    SimResults* results;
+    unsigned long long seed;
+    long long total_rolls;
+    double start_time;              // Time the earliest chunk started, 0 until a chunk has been merged
+    int shortest_iteration;         // Iteration that produced the shortest game
+    TaskGroup group;
+    SimCallback on_complete;
+    void* callback_arg;
+    pthread_mutex_t lock;           // Protects the results while chunks are merged
+    pthread_cond_t finished;
+    int done;
+} SimRun;
+
+/**
+ * @brief Starts simulating the board game on the given scheduler.
+ *
+ * The iterations are split into chunks of `SIM_CHUNK_ITERATIONS` games that the scheduler's workers play
+ * in parallel. Every chunk draws its rolls from its own generator derived from the seed, so the results of
+ * a seeded run do not depend on the number of workers. All memory is taken from the arena before the first
+ * game is played, the simulation itself does not allocate.
+ *
+ * @param board Pointer to an initialized GameBoard.
+ * @param config Pointer to the simulation configuration.
+ * @param arena Pointer to the arena that owns the run, the returned SimResults and its shortest roll sequence.
+ * @param scheduler Pointer to the scheduler that plays the games.
+ * @param on_complete Called on a worker thread with the results once every game has been played, or NULL to
+ *                    collect the results with `wait_sim`.
+ * @param callback_arg Passed to `on_complete`.
+ * @return Pointer to the running simulation, or NULL if allocation fails.
+ */
+SimRun* start_sim(GameBoard* board, Config* config, Arena* arena, Scheduler* scheduler, SimCallback on_complete, void* callback_arg);
+
+/**
+ * @brief Waits until a simulation started without completion callback has finished.
+ *
+ * Must not be called from a scheduler worker.
+ *
+ * @param run Pointer to the running simulation.
+ * @return Pointer to the SimResults structure, or NULL if the run is invalid.
+ */
+SimResults* wait_sim(SimRun* run);
+
 /**
  * @brief Simulates the board game and collects statistics.
  *
- * Runs the simulation for a number of iterations based on the provided configuration.
+ * Runs the simulation for a number of iterations based on the provided configuration and waits for it.
  * Collects statistics such as average rolls to win, overshoots, snake/ladder usage, aborted iterations,
- * and the shortest roll sequence. Memory for the results and shortest roll sequence is dynamically allocated.
+ * and the shortest roll sequence.
  *
  * @param board Pointer to an initialized GameBoard.
  * @param config Pointer to the simulation configuration.
- * @return Pointer to a dynamically allocated SimResults structure, or NULL if allocation fails.
- *
- * @note The caller must free the returned SimResults (and its shortest_roll_sequence if set).
+ * @param arena Pointer to the arena that owns the returned SimResults and its shortest roll sequence.
+ * @param scheduler Pointer to the scheduler that plays the games.
+ * @return Pointer to the SimResults structure, or NULL if allocation fails.
  */
-SimResults* run_sim(GameBoard* board, Config* config);
+SimResults* run_sim(GameBoard* board, Config* config, Arena* arena, Scheduler* scheduler);
 
 /**
  * @brief Prints the results of a simulation in a readable format.
@@ -0,0 +1,295 @@
+#define _POSIX_C_SOURCE 200809L
+#include "sweep.h"
+#include "game_board.h"
+#include "sim.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+
+static const char* SWEEP_KEY_NAMES[] = {
+    "ITERATIONS", "MAXSIMSTEPS", "ROWS", "COLS", "DICE", "ALLOW_OVERSHOOT"
+};
+
+typedef struct {
+    Config config;
+    GameBoard* board;
+    SimRun* run;
+    SimResults* results;
+} SweepVariant;
+
+typedef struct {
+    SweepVariant* variants;
+    int num_variants;
+} SweepJob;
+
+/**
+ * @brief Checks a swept value with the same constraints the config parser applies to the key.
+ */
+static int is_valid_sweep_value(SweepKey key, int value) {
+    switch (key) {
+        case SWEEP_DICE:
+            return value >= 2;
+        case SWEEP_ALLOW_OVERSHOOT:
+            return value == 0 || value == 1;
+        default:
+            return value > 0;
+    }
+}
+
+/**
+ * @brief Parses a range `a..b` or `a..b:step`, returns 1 only if the whole text is such a range.
+ */
+static int parse_sweep_range(const char* text, int* from, int* to, int* step) {
+    int consumed = -1;
+    *step = 1;
+    if (sscanf(text, "%d..%d:%d%n", from, to, step, &consumed) == 3 && text[consumed] == '\0') return 1;
+    consumed = -1;
+    *step = 1;
+    return sscanf(text, "%d..%d%n", from, to, &consumed) == 2 && text[consumed] == '\0';
+}
+
+/**
+ * @brief Parses a single swept value, `ALLOW_OVERSHOOT` accepts `true` and `false`.
+ */
+static int parse_sweep_value(SweepKey key, const char* text, int* value) {
+    if (key == SWEEP_ALLOW_OVERSHOOT) {
+        if (strcmp(text, "true") == 0) { *value = 1; return 0; }
+        if (strcmp(text, "false") == 0) { *value = 0; return 0; }
+    }
+
+    char* end;
+    errno = 0;
+    long parsed = strtol(text, &end, 10);
+    if (end == text || *end != '\0' || errno == ERANGE || parsed < INT_MIN || parsed > INT_MAX) return 1;
+    *value = (int) parsed;
+    return 0;
+}
+
+int parse_sweep_arg(const char* arg, SweepSpec* spec) {
+    if (!arg || !spec) {
+        LOG_ERROR("Invalid argument or sweep spec (NULL pointer).");
+        return 1;
+    }
+    if (spec->num_dimensions >= MAX_SWEEP_DIMENSIONS) {
+        LOG_ERROR("Too many sweep dimensions.");
+        return 1;
+    }
+
+    const char* values = strchr(arg, '=');
+    if (!values) {
+        LOG_ERROR("Sweep dimensions need to have the format KEY=VALUES e.g. 'DICE=2..20'.");
+        return 1;
+    }
+
+    SweepDimension* dim = &spec->dimensions[spec->num_dimensions];
+    int key_found = 0;
+    for (int k = 0; k <= SWEEP_ALLOW_OVERSHOOT; k++) {
+        if (strlen(SWEEP_KEY_NAMES[k]) == (size_t) (values - arg) && strncmp(arg, SWEEP_KEY_NAMES[k], values - arg) == 0) {
+            dim->key = (SweepKey) k;
+            key_found = 1;
+            break;
+        }
+    }
+    if (!key_found) {
+        LOG_ERROR("Unknown sweep key, use ITERATIONS, MAXSIMSTEPS, ROWS, COLS, DICE or ALLOW_OVERSHOOT.");
+        return 1;
+    }
+    values++;
+    dim->num_values = 0;
+
+    int from, to, step;
+    if (dim->key != SWEEP_ALLOW_OVERSHOOT && parse_sweep_range(values, &from, &to, &step)) {
+        // Range of values
+        if (step <= 0 || from > to) {
+            LOG_ERROR("Sweep ranges need to be ascending with a positive step.");
+            return 1;
+        }
+        for (int v = from; ; v += step) {
+            if (dim->num_values >= MAX_SWEEP_VALUES) {
+                LOG_ERROR("Too many values in sweep dimension.");
+                return 1;
+            }
+            dim->values[dim->num_values++] = v;
+            // Stop before stepping past `to`, v + step could overflow near INT_MAX
+            if (to - v < step) break;
+        }
+    } else {
+        // Comma separated list of values
+        char buffer[MAX_LINE_LENGTH];
+        strncpy(buffer, values, MAX_LINE_LENGTH - 1);
+        buffer[MAX_LINE_LENGTH - 1] = '\0';
+
+        for (char* token = strtok(buffer, ","); token; token = strtok(NULL, ",")) {
+            if (dim->num_values >= MAX_SWEEP_VALUES) {
+                LOG_ERROR("Too many values in sweep dimension.");
+                return 1;
+            }
+            if (parse_sweep_value(dim->key, token, &dim->values[dim->num_values])) {
+                LOG_ERROR("Could not parse sweep value.");
+                return 1;
+            }
+            dim->num_values++;
+        }
+    }
+
+    for (int i = 0; i < dim->num_values; i++) {
+        if (!is_valid_sweep_value(dim->key, dim->values[i])) {
+            LOG_ERROR("Sweep value violates the constraints of its config key.");
+            return 1;
+        }
+    }
+    if (dim->num_values == 0) {
+        LOG_ERROR("Sweep dimension has no values.");
+        return 1;
+    }
+
+    spec->num_dimensions++;
+    return 0;
+}
+
+/**
+ * @brief Builds the configuration of one variant from the base configuration.
+ *
+ * The variant index is decomposed into one value index per dimension, the last dimension changes fastest.
+ * Snakes and ladders are copied from the base configuration as they are.
+ */
+static void build_variant_config(Config* base, SweepSpec* spec, int index, Config* config) {
+    memcpy(config, base, sizeof(Config));
+    if (base->seed) config->seed = base->seed + index;
+
+    for (int d = spec->num_dimensions - 1; d >= 0; d--) {
+        SweepDimension* dim = &spec->dimensions[d];
+        int value = dim->values[index % dim->num_values];
+        index /= dim->num_values;
+
+        switch (dim->key) {
+            case SWEEP_ITERATIONS:      config->iterations = value; break;
+            case SWEEP_MAXSIMSTEPS:     config->max_simulation_steps = value; break;
+            case SWEEP_ROWS:            config->rows = value; break;
+            case SWEEP_COLS:            config->cols = value; break;
+            case SWEEP_DICE:            config->dice_sides = value; break;
+            case SWEEP_ALLOW_OVERSHOOT: config->allow_overshoot = value; break;
+        }
+    }
+
+}
+
+/**
+ * @brief Validates the base snakes and ladders again for a variant with a different board size.
+ *
+ * Only transitions that are still valid on the resized board are kept.
+ */
+static void revalidate_transitions(Config* base, Config* config) {
+    config->num_snakes = 0;
+    config->num_ladders = 0;
+    for (int i = 0; i < base->num_snakes; i++) {
+        if (validate_transition(base->snakes[i].start, base->snakes[i].end, 1, config->num_snakes, config->num_ladders, config)) {
+            config->snakes[config->num_snakes++] = base->snakes[i];
+        }
+    }
+    for (int i = 0; i < base->num_ladders; i++) {
+        if (validate_transition(base->ladders[i].start, base->ladders[i].end, 0, config->num_snakes, config->num_ladders, config)) {
+            config->ladders[config->num_ladders++] = base->ladders[i];
+        }
+    }
+}
+
+static void print_sweep_table(SweepJob* job) {
+    printf("%7s %6s %6s %6s %10s %12s %11s %10s %10s %10s %11s %10s %9s %10s\n",
+        "variant", "rows", "cols", "dice", "overshoot", "maxsimsteps", "iterations",
+        "avg_rolls", "games_won", "aborted", "abort_rate", "overshots", "shortest", "time_s");
+
+    for (int i = 0; i < job->num_variants; i++) {
+        Config* c = &job->variants[i].config;
+        SimResults* r = job->variants[i].results;
+        printf("%7d %6d %6d %6d %10s %12d %11d %10.3f %10d %10d %11.4f %10d %9d %10.3f\n",
+            i, c->rows, c->cols, c->dice_sides, c->allow_overshoot ? "true" : "false",
+            c->max_simulation_steps, c->iterations, r->avg_rolls, c->iterations - r->aborted_iterations,
+            r->aborted_iterations, (double) r->aborted_iterations / c->iterations, r->overshots,
+            r->shortest_num_of_rolls, r->elapsed_time);
+    }
+}
+
+int run_sweep(Config* base, SweepSpec* spec, Scheduler* scheduler) {
+    if (!base || !spec || !scheduler) {
+        LOG_ERROR("Invalid config, sweep spec or scheduler (NULL pointer).");
+        return 1;
+    }
+
+    long num_variants = 1;
+    for (int d = 0; d < spec->num_dimensions; d++) {
+        num_variants *= spec->dimensions[d].num_values;
+        if (num_variants > MAX_SWEEP_VARIANTS) {
+            LOG_ERROR("Sweep spans too many variants.");
+            return 1;
+        }
+    }
+
+    // The arena owns variants, boards and results
+    Arena arena;
+    arena_init(&arena, 0);
+
+    SweepJob job = { .num_variants = (int) num_variants };
+    job.variants = arena_calloc(&arena, num_variants, sizeof(SweepVariant));
+    if (!job.variants) {
+        LOG_ERROR("Memory allocation failed for sweep variants.");
+        arena_free(&arena);
+        return 1;
+    }
+
+    // Build variants and share boards between variants with the same size and dice
+    for (int i = 0; i < job.num_variants; i++) {
+        SweepVariant* variant = &job.variants[i];
+        build_variant_config(base, spec, i, &variant->config);
+        int resized = variant->config.rows != base->rows || variant->config.cols != base->cols;
+        int revalidated = !resized;
+
+        for (int j = 0; j < i; j++) {
+            Config* other = &job.variants[j].config;
+            if (other->rows != variant->config.rows || other->cols != variant->config.cols) continue;
+
+            // Same board size, reuse the already validated snakes and ladders
+            if (!revalidated) {
+                variant->config.num_snakes = other->num_snakes;
+                variant->config.num_ladders = other->num_ladders;
+                memcpy(variant->config.snakes, other->snakes, sizeof(Transition) * other->num_snakes);
+                memcpy(variant->config.ladders, other->ladders, sizeof(Transition) * other->num_ladders);
+                revalidated = 1;
+            }
+            if (other->dice_sides == variant->config.dice_sides) {
+                variant->board = job.variants[j].board;
+                break;
+            }
+        }
+        if (!revalidated) revalidate_transitions(base, &variant->config);
+        if (!variant->board) {
+            variant->board = create_game_board(&variant->config, &arena);
+        }
+    }
+    LOG_DEBUG("Built sweep variants and boards successfully.");
+    log_flush();
+
+    // Queue every variant at once, the scheduler interleaves their chunks over all workers
+    for (int i = 0; i < job.num_variants; i++) {
+        SweepVariant* variant = &job.variants[i];
+        variant->run = start_sim(variant->board, &variant->config, &arena, scheduler, NULL, NULL);
+    }
+
+    int failed = 0;
+    for (int i = 0; i < job.num_variants; i++) {
+        SweepVariant* variant = &job.variants[i];
+        variant->results = variant->run ? wait_sim(variant->run) : NULL;
+        if (!variant->results) failed = 1;
+    }
+
+    if (failed) {
+        LOG_ERROR("At least one sweep variant failed to simulate.");
+    } else {
+        print_sweep_table(&job);
+    }
+
+    arena_free(&arena);
+    return failed;
+}
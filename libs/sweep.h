@@ -0,0 +1,52 @@
+#pragma once
+#include "config_manager.h"
+#include "scheduler.h"
+
+#define MAX_SWEEP_DIMENSIONS 8
+#define MAX_SWEEP_VALUES 256
+#define MAX_SWEEP_VARIANTS 4096
+
+typedef enum {
+    SWEEP_ITERATIONS, SWEEP_MAXSIMSTEPS, SWEEP_ROWS, SWEEP_COLS, SWEEP_DICE, SWEEP_ALLOW_OVERSHOOT
+} SweepKey;
+
+typedef struct {
+    SweepKey key;
+    int num_values;
+    int values[MAX_SWEEP_VALUES];
+} SweepDimension;
+
+typedef struct {
+    int num_dimensions;
+    SweepDimension dimensions[MAX_SWEEP_DIMENSIONS];
+} SweepSpec;
+
+/**
+ * @brief Parses a single sweep dimension and appends it to a sweep specification.
+ *
+ * A dimension has the format `KEY=VALUES` where `KEY` is one of `ITERATIONS`, `MAXSIMSTEPS`, `ROWS`, `COLS`,
+ * `DICE` or `ALLOW_OVERSHOOT`. `VALUES` is either an inclusive range `a..b` with an optional step (`a..b:step`)
+ * or a comma separated list (e.g. `2,6,10` or `true,false`). Values are validated with the same rules as
+ * the configuration file.
+ *
+ * @param arg The dimension to parse, e.g. `DICE=2..20`.
+ * @param spec Pointer to the `SweepSpec` the dimension is appended to.
+ * @return int Returns `0` on success, `1` on failure (e.g. unknown key, invalid value, too many values).
+ */
+int parse_sweep_arg(const char* arg, SweepSpec* spec);
+
+/**
+ * @brief Runs every variant in the grid spanned by a sweep specification and prints one table row per variant.
+ *
+ * Each variant is a copy of the base configuration with the swept values applied. The already parsed and
+ * validated snakes and ladders are reused, they are only validated again if the board size changes.
+ * Variants with the same board size and dice share one game board. Variants are simulated in parallel on the scheduler.
+ *
+ * @param base Pointer to the parsed base configuration.
+ * @param spec Pointer to the sweep specification, every combination of its values is simulated.
+ * @param scheduler Pointer to the scheduler that plays the games of every variant.
+ * @return int Returns `0` on success, `1` on failure (e.g. too many variants, failed simulation).
+ *
+ * @note If the base configuration has a seed, variant `i` is simulated with seed `seed + i`.
+ */
+int run_sweep(Config* base, SweepSpec* spec, Scheduler* scheduler);
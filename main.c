@@ -3,45 +3,152 @@
 #include <string.h>
 #include <ctype.h>
 #include "libs/game_board.h"
+#include "libs/board_view.h"
 #include "libs/config_manager.h"
 #include "libs/sim.h"
+#include "libs/editor.h"
+#include "libs/sweep.h"
+#include "libs/server.h"
 #include <time.h>
 
 int main(int argc, char** args) {
-    if (argc != 2) {
-        logm(ERROR, "main", "A config file is required when trying to run executable e.g. './main game_configs/default.txt'!");
+    // -v enables debug output and takes precedence over LOG_LEVEL in the config file,
+    // --pin pins the scheduler's worker threads to CPUs
+    int verbose = 0, pin_threads = 0;
+    while (argc > 1 && (strcmp(args[1], "-v") == 0 || strcmp(args[1], "--pin") == 0)) {
+        if (strcmp(args[1], "-v") == 0) verbose = 1; else pin_threads = 1;
+        args++;
+        argc--;
+    }
+    log_init(verbose ? DEBUG : INFO);
+    if (verbose) lock_log_level();
+
+    if (argc > 1 && strcmp(args[1], "--serve") == 0 && argc <= 3) {
+        // Server mode: jobs bring their own configuration
+        set_log_immediate(1);
+        Scheduler* scheduler = create_scheduler(0, pin_threads);
+        int return_val = !scheduler || run_server(argc == 3 ? args[2] : NULL, scheduler);
+        if (scheduler && verbose) print_scheduler_stats(scheduler, stderr);
+        destroy_scheduler(scheduler);
+        if (return_val) {
+            LOG_ERROR("An error occured while running the server.");
+            exit(EXIT_FAILURE);
+        }
+        return 0;
+    }
+
+    int edit_mode = argc > 2 && strcmp(args[2], "--edit") == 0;
+    int sweep_mode = argc > 3 && strcmp(args[2], "--sweep") == 0;
+    // View options of a normal run select which part of the board is printed
+    int show_rows = argc == 4 && strcmp(args[2], "--show-rows") == 0;
+    int show_summary = argc == 3 && strcmp(args[2], "--summary") == 0;
+    if (argc < 2 || (argc > 2 && !edit_mode && !sweep_mode && !show_rows && !show_summary) || (edit_mode && argc > 4)) {
+        LOG_ERROR("A config file is required when trying to run executable e.g. './main [-v] [--pin] game_configs/default.txt [--show-rows a..b | --summary | --edit [script] | --sweep KEY=VALUES...]' or './main [-v] [--pin] --serve [socket]'!");
         exit(EXIT_FAILURE);
     }
 
-    Config* config = malloc(sizeof(Config));
+    // The run arena owns everything that lives until the end of the program
+    Arena arena;
+    arena_init(&arena, 0);
+
+    Config* config = arena_alloc(&arena, sizeof(Config));
     int return_val = parse_config_file(args[1], config);
     if (return_val) {
-        free(config);
-        logm(ERROR, "main", "An error occured during config parse phase.");
+        arena_free(&arena);
+        LOG_ERROR("An error occured during config parse phase.");
+        exit(EXIT_FAILURE);
+    }
+
+    LOG_DEBUG("Parsed configuration file successfully!");
+
+    if (sweep_mode) {
+        // Sweep mode: every remaining argument is one dimension of the sweep grid
+        SweepSpec* spec = arena_calloc(&arena, 1, sizeof(SweepSpec));
+        return_val = (spec == NULL);
+        for (int i = 3; i < argc && !return_val; i++) {
+            return_val = parse_sweep_arg(args[i], spec);
+        }
+        Scheduler* scheduler = return_val ? NULL : create_scheduler(0, pin_threads);
+        if (scheduler) {
+            return_val = run_sweep(config, spec, scheduler);
+            // Keep stdout to the table so it can be piped into other tools
+            if (!return_val && verbose) print_scheduler_stats(scheduler, stderr);
+        } else {
+            return_val = 1;
+        }
+        destroy_scheduler(scheduler);
+        arena_free(&arena);
+        if (return_val) {
+            LOG_ERROR("An error occured during parameter sweep.");
+            exit(EXIT_FAILURE);
+        }
+        return 0;
+    }
+
+    if (edit_mode) {
+        // Edit mode: read edits from the given script or from stdin
+        set_log_immediate(1);
+        FILE* script = (argc == 4) ? fopen(args[3], "r") : stdin;
+        if (!script) {
+            arena_free(&arena);
+            LOG_ERROR("Encounterd error when trying to open given edit script, it might not exists!");
+            exit(EXIT_FAILURE);
+        }
+
+        return_val = run_edit_script(script, config);
+        if (script != stdin) fclose(script);
+        arena_free(&arena);
+        if (return_val) {
+            LOG_ERROR("An error occured during edit session.");
+            exit(EXIT_FAILURE);
+        }
+        return 0;
+    }
+
+    int first_row = 0, last_row = 0;
+    if (show_rows && parse_row_range(args[3], &first_row, &last_row)) {
+        arena_free(&arena);
         exit(EXIT_FAILURE);
     }
 
-    logm(DEBUG, "main", "Parsed configuration file successfully!");
     // print_board_config(config);
-    GameBoard* board = create_game_board(config);
-    print_game_board(board);
+    GameBoard* board = create_game_board(config, &arena);
+    if (!board) {
+        arena_free(&arena);
+        LOG_ERROR("An error occured while creating the game board.");
+        exit(EXIT_FAILURE);
+    }
+    if (show_rows) {
+        print_board_rows(board, first_row, last_row);
+    } else if (show_summary || board->rows * board->cols > BOARD_VIEW_MAX_FIELDS) {
+        // Large boards are only rendered on request, the full grid would be megabytes of output
+        if (!show_summary) {
+            LOG_INFO("Board has more than %d squares, printing a summary instead. Use --show-rows a..b to print rows.", BOARD_VIEW_MAX_FIELDS);
+        }
+        Arena scratch;
+        arena_init(&scratch, 0);
+        print_board_summary(board, config, &scratch);
+        arena_free(&scratch);
+    } else {
+        print_game_board(board);
+    }
     
-    logm(DEBUG, "main", "Starting simulation now.");
-    SimResults* results = run_sim(board, config);
+    Scheduler* scheduler = create_scheduler(0, pin_threads);
+    LOG_DEBUG("Starting simulation now.");
+    SimResults* results = scheduler ? run_sim(board, config, &arena, scheduler) : NULL;
     if (results == NULL) {
-        free(config);
-        free_board(board);
-        logm(ERROR, "main", "An error occured within run_sim and it returned NULL. Terminating program.");
+        destroy_scheduler(scheduler);
+        arena_free(&arena);
+        LOG_ERROR("An error occured within run_sim and it returned NULL. Terminating program.");
         exit(EXIT_FAILURE);
     }
 
     print_sim_results(results, config);
-    logm(DEBUG, "main", "Successfully ended simulation.");
+    print_scheduler_stats(scheduler, stdout);
+    LOG_DEBUG("Successfully ended simulation.");
     
-    logm(DEBUG, "main", "About to free resources.");
-    free_board(board);
-    free(config);
-    free(results->shortest_roll_sequence);
-    free(results);
-    logm(DEBUG, "main", "Freed resources successfully!");
+    LOG_DEBUG("About to free resources.");
+    destroy_scheduler(scheduler);
+    arena_free(&arena);
+    LOG_DEBUG("Freed resources successfully!");
 }
\ No newline at end of file